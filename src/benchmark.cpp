@@ -1,5 +1,6 @@
 // Time the different CCD methods
 
+#include <memory>
 #include <vector>
 
 #include <CLI/CLI.hpp>
@@ -9,6 +10,12 @@
 #include <ghc/fs_std.hpp> // filesystem
 
 #include <ccd.hpp>
+#include <ccd_batch.hpp>
+#include <ccd_cascade.hpp>
+#include <ccd_executor.hpp>
+#include <ccd_filters.hpp>
+#include <ccd_normalization.hpp>
+#include <ccd_obstacle.hpp>
 #include <utils/read_rational_csv.hpp>
 #include <utils/timer.hpp>
 
@@ -32,6 +39,9 @@ struct CLIArgs {
     bool run_vf_dataset = true;
     bool run_simulation_dataset = true;
     bool run_handcrafted_dataset = true;
+    bool use_non_penetration_filter = false;
+    bool normalize_queries = false;
+    std::vector<unsigned> scaling_threads;
 
     CLIArgs(int argc, char* argv[])
     {
@@ -104,6 +114,18 @@ struct CLIArgs {
             "!--no-handcrafted", run_handcrafted_dataset,
             "do not run the handcrafted dataset");
 
+        app.add_flag(
+            "--filter", use_non_penetration_filter,
+            "run the non-penetration filter before the methods");
+        app.add_flag(
+            "--normalize", normalize_queries,
+            "translate the queries to a local origin before the methods");
+
+        app.add_option(
+            "-t,--threads", scaling_threads,
+            "measure the thread scaling of the batched functions with these "
+            "numbers of threads instead of timing each query");
+
         try {
             app.parse(argc, argv);
         } catch (const CLI::ParseError& e) {
@@ -116,12 +138,128 @@ struct CLIArgs {
     }
 };
 
+/// Load the queries of a dataset packed for the batched functions.
+void load_rational_data(
+    const CLIArgs& args,
+    const bool is_edge_edge,
+    const bool is_simulation_data,
+    std::vector<double>& queries,
+    std::vector<bool>& expected_results)
+{
+    std::string sub_folder = is_edge_edge ? "edge-edge" : "vertex-face";
+
+    const std::vector<std::string>& scene_names
+        = is_simulation_data ? simulation_folders : handcrafted_folders;
+
+    std::vector<bool> results;
+    for (const auto& scene_name : scene_names) {
+        fs::path scene_path = args.data_dir / scene_name / sub_folder;
+        if (!fs::exists(scene_path)) {
+            std::cout << "Missing: " << scene_path.string() << std::endl;
+            continue;
+        }
+
+        for (const auto& entry : fs::directory_iterator(scene_path)) {
+            if (entry.path().extension() != ".csv") {
+                continue;
+            }
+
+            const Eigen::MatrixXd all_V =
+                read_rational_csv(entry.path().string(), results);
+            assert(all_V.rows() % 8 == 0 && all_V.cols() == 3);
+
+            for (int i = 0; i < all_V.rows(); i++) {
+                for (int j = 0; j < 3; j++) {
+                    queries.push_back(all_V(i, j));
+                }
+            }
+            for (int i = 0; i < all_V.rows() / 8; i++) {
+                expected_results.push_back(results[i * 8]);
+            }
+        }
+    }
+}
+
+/// Time the batched functions of a method with executors of each number of
+/// threads of args.scaling_threads, relative to the first.
+void run_thread_scaling_single_method(
+    const CLIArgs& args,
+    const CCDMethod method,
+    const bool is_edge_edge,
+    const bool is_simulation_data)
+{
+    std::vector<double> queries;
+    std::vector<bool> expected_results;
+    load_rational_data(
+        args, is_edge_edge, is_simulation_data, queries, expected_results);
+    const size_t num_queries = expected_results.size();
+    std::unique_ptr<bool[]> hits(new bool[num_queries]);
+
+    Timer timer;
+    double base_time = 0;
+    for (const unsigned num_threads : args.scaling_threads) {
+        Executor executor(num_threads);
+
+        timer.start();
+        if (is_minimum_separation_method(method)) {
+            if (is_edge_edge) {
+                edgeEdgeMSCCDBatch(
+                    executor, queries.data(), num_queries,
+                    args.minimum_separation, method, hits.get(),
+                    args.tight_inclusion_tolerance,
+                    args.tight_inclusion_max_iter);
+            } else {
+                vertexFaceMSCCDBatch(
+                    executor, queries.data(), num_queries,
+                    args.minimum_separation, method, hits.get(),
+                    args.tight_inclusion_tolerance,
+                    args.tight_inclusion_max_iter);
+            }
+        } else {
+            if (is_edge_edge) {
+                edgeEdgeCCDBatch(
+                    executor, queries.data(), num_queries, method, hits.get(),
+                    args.tight_inclusion_tolerance,
+                    args.tight_inclusion_max_iter);
+            } else {
+                vertexFaceCCDBatch(
+                    executor, queries.data(), num_queries, method, hits.get(),
+                    args.tight_inclusion_tolerance,
+                    args.tight_inclusion_max_iter);
+            }
+        }
+        timer.stop();
+        const double time = timer.getElapsedTimeInSec();
+        if (base_time == 0) {
+            base_time = time;
+        }
+
+        int num_false_negatives = 0;
+        for (size_t i = 0; i < num_queries; i++) {
+            num_false_negatives += expected_results[i] && !hits[i];
+        }
+
+        fmt::print(
+            "threads: {:d}, time: {:g}s, speedup: {:.2f}x, "
+            "# of false negatives: {:d}\n",
+            executor.num_threads(), time, base_time / time,
+            num_false_negatives);
+    }
+    std::cout << std::endl;
+}
+
 void run_rational_data_single_method(
     const CLIArgs& args,
     const CCDMethod method,
     const bool is_edge_edge,
     const bool is_simulation_data)
 {
+    if (!args.scaling_threads.empty()) {
+        run_thread_scaling_single_method(
+            args, method, is_edge_edge, is_simulation_data);
+        return;
+    }
+
     bool use_msccd = is_minimum_separation_method(method);
     Eigen::MatrixXd all_V;
     std::vector<bool> results;
@@ -132,6 +270,12 @@ void run_rational_data_single_method(
     int total_positives = 0;
     int num_false_positives = 0;
     int num_false_negatives = 0;
+    resetNonPenetrationFilterStats();
+    resetPrecisionCascadeStats();
+    resetRootParityFilterStats();
+    resetZeroMotionStats();
+    resetStaticObstacleStats();
+    resetQueryNormalizationStats();
 
     std::string sub_folder = is_edge_edge ? "edge-edge" : "vertex-face";
 
@@ -238,6 +382,45 @@ void run_rational_data_single_method(
                                     : fmt::terminal_color::green),
             "{:d}", num_false_negatives),
         total_time / double(total_number + 1));
+    if (isNonPenetrationFilterEnabled(method)) {
+        fmt::print(
+            "filter rejection rate: {:.1f}%\n\n",
+            100 * nonPenetrationFilterStats(method).rejection_rate());
+    }
+    if (rootParityFilterStats(method).num_queries > 0) {
+        fmt::print(
+            "root parity filter rejection rate: {:.1f}%\n\n",
+            100 * rootParityFilterStats(method).rejection_rate());
+    }
+    if (zeroMotionStats().num_answered > 0) {
+        fmt::print(
+            "zero-motion fast path: {:d} static, {:d} translating, "
+            "{:d} answered\n\n",
+            zeroMotionStats().num_static, zeroMotionStats().num_translating,
+            zeroMotionStats().num_answered);
+    }
+    if (staticObstacleStats().num_queries > 0) {
+        fmt::print(
+            "static obstacle kernels: {:d} queries, {:.1f}% decided\n\n",
+            staticObstacleStats().num_queries,
+            100 * staticObstacleStats().decided_rate());
+    }
+    if (queryNormalizationStats().num_queries > 0) {
+        fmt::print(
+            "normalization: {:d} of {:d} queries translated\n\n",
+            queryNormalizationStats().num_shifted,
+            queryNormalizationStats().num_queries);
+    }
+    if (method == CCDMethod::PRECISION_CASCADE) {
+        const CascadeStats stats = precisionCascadeStats();
+        fmt::print(
+            "cascade tiers: {:.1f}% coarse, {:.1f}% tight inclusion, "
+            "{:.1f}% rational root parity, {:d} unresolved\n\n",
+            100 * stats.resolved_rate(COARSE_TIGHT_INCLUSION_TIER),
+            100 * stats.resolved_rate(TIGHT_INCLUSION_TIER),
+            100 * stats.resolved_rate(RATIONAL_ROOT_PARITY_TIER),
+            stats.num_unresolved);
+    }
 }
 
 void run_one_method_over_all_data(const CLIArgs& args, const CCDMethod method)
@@ -274,6 +457,8 @@ void run_all_methods(const CLIArgs& args)
 {
     for (CCDMethod method : args.methods) {
         if (is_method_enabled(method)) {
+            setNonPenetrationFilter(method, args.use_non_penetration_filter);
+            setQueryNormalization(args.normalize_queries);
             fmt::print(
                 fmt::emphasis::bold | fmt::emphasis::underline,
                 "Benchmarking {}\n", method_names[method]);
@@ -0,0 +1,205 @@
+// Time the broad phases on a deforming cloth
+//
+// Animates an n × n grid of triangles folding over itself, and times every
+// frame the swept boxes, the refit and traversal of the bounding volume
+// hierarchies, the incremental sort and sweep of the sweep and prune, and the
+// spatial hash for comparison. The hierarchies and sorted lists are built once
+// before the first frame. Also times the pairs of faces and their expansion
+// with representative triangles, and compares the number of elementary pairs
+// to a naive expansion of the pairs of faces.
+
+#include <cmath>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+#include <Eigen/Core>
+#include <fmt/format.h>
+
+#include <ccd_broad_phase.hpp>
+#include <ccd_bvh.hpp>
+#include <ccd_representative_triangles.hpp>
+#include <ccd_spatial_hash.hpp>
+#include <ccd_sweep_and_prune.hpp>
+#include <utils/timer.hpp>
+
+using namespace ccd;
+
+struct CLIArgs {
+    int resolution = 200;
+    int num_frames = 50;
+    unsigned num_threads = 0;
+    double rebuild_threshold = MeshBVH().rebuild_threshold;
+
+    CLIArgs(int argc, char* argv[])
+    {
+        CLI::App app { "CCD Broad Phase Benchmark" };
+
+        app.add_option("-n,--resolution", resolution, "cloth resolution")
+            ->default_val(resolution);
+        app.add_option("-f,--frames", num_frames, "number of frames")
+            ->default_val(num_frames);
+        app.add_option(
+               "-t,--threads", num_threads,
+               "number of threads (0 for all hardware threads)")
+            ->default_val(num_threads);
+        app.add_option(
+               "--rebuild-threshold", rebuild_threshold,
+               "cost ratio above which the hierarchies are rebuilt")
+            ->default_val(rebuild_threshold);
+
+        try {
+            app.parse(argc, argv);
+        } catch (const CLI::ParseError& e) {
+            exit(app.exit(e));
+        }
+    }
+};
+
+// Triangles and edges of an n × n grid
+void cloth_topology(const int n, Eigen::MatrixXi& E, Eigen::MatrixXi& F)
+{
+    F.resize(2 * n * n, 3);
+    E.resize(3 * n * n + 2 * n, 2);
+    int e = 0;
+    for (int i = 0; i <= n; i++) {
+        for (int j = 0; j <= n; j++) {
+            const int v = i * (n + 1) + j;
+            if (j < n) {
+                E.row(e++) << v, v + 1;
+            }
+            if (i < n) {
+                E.row(e++) << v, v + n + 1;
+            }
+            if (i < n && j < n) {
+                E.row(e++) << v + 1, v + n + 1;
+                F.row(2 * (i * n + j)) << v, v + n + 1, v + 1;
+                F.row(2 * (i * n + j) + 1) << v + 1, v + n + 1, v + n + 2;
+            }
+        }
+    }
+}
+
+// Vertices of the grid rolled around an axis by an angle growing with time,
+// so the cloth folds over itself and the hierarchies degrade.
+Eigen::MatrixXd cloth_positions(const int n, const double time)
+{
+    Eigen::MatrixXd V((n + 1) * (n + 1), 3);
+    for (int i = 0; i <= n; i++) {
+        for (int j = 0; j <= n; j++) {
+            const double x = double(i) / n, y = double(j) / n;
+            const double angle = 2 * M_PI * time * x;
+            const double radius = 0.25 + 0.01 * std::sin(8 * M_PI * y);
+            const double px = (1 - time) * x + radius * std::sin(angle);
+            V.row(i * (n + 1) + j) << px, y, radius * (1 - std::cos(angle));
+        }
+    }
+    return V;
+}
+
+int main(int argc, char* argv[])
+{
+    const CLIArgs args(argc, argv);
+    Executor executor(args.num_threads);
+
+    Eigen::MatrixXi E, F;
+    cloth_topology(args.resolution, E, F);
+    fmt::print(
+        "Cloth: {:d} vertices, {:d} edges, {:d} faces, {:d} threads\n\n",
+        (args.resolution + 1) * (args.resolution + 1), E.rows(), F.rows(),
+        executor.num_threads());
+
+    Timer timer;
+    const auto elapsed = [&]() {
+        timer.stop();
+        const double ms = 1e-3 * timer.getElapsedTimeInMicroSec();
+        timer.start();
+        return ms;
+    };
+
+    MeshBVH bvh;
+    bvh.rebuild_threshold = args.rebuild_threshold;
+    timer.start();
+    bvh.build(
+        executor, cloth_positions(args.resolution, 0),
+        cloth_positions(args.resolution, 1.0 / args.num_frames), E, F);
+    const double build_time = elapsed();
+    SweepAndPrune sap;
+    sap.build(
+        executor, cloth_positions(args.resolution, 0),
+        cloth_positions(args.resolution, 1.0 / args.num_frames), E, F);
+    const double sort_time = elapsed();
+    const RepresentativeTriangles triangles(E, F);
+
+    std::vector<SweptBox> vertex_boxes, edge_boxes, face_boxes;
+    std::vector<VertexFaceCandidate> vf_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    double boxes_time = 0, update_time = 0, traversal_time = 0;
+    double sap_update_time = 0, sweep_time = 0, hash_time = 0;
+    size_t num_candidates = 0, num_swaps = 0, num_sorts = 0;
+    std::vector<FaceFaceCandidate> ff_candidates;
+    double face_pairs_time = 0, expansion_time = 0;
+    size_t num_face_pairs = 0, num_representative = 0;
+    for (int frame = 0; frame < args.num_frames; frame++) {
+        const Eigen::MatrixXd V0 = cloth_positions(
+            args.resolution, double(frame) / args.num_frames);
+        const Eigen::MatrixXd V1 = cloth_positions(
+            args.resolution, double(frame + 1) / args.num_frames);
+
+        elapsed();
+        sweptBoxes(
+            executor, V0, V1, E, F, 0, vertex_boxes, edge_boxes, face_boxes);
+        boxes_time += elapsed();
+        bvh.update(executor, V0, V1);
+        update_time += elapsed();
+        bvh.candidates(executor, vf_candidates, ee_candidates);
+        traversal_time += elapsed();
+        num_candidates += vf_candidates.size() + ee_candidates.size();
+
+        num_sorts += sap.update(executor, V0, V1);
+        num_swaps += sap.num_swaps();
+        sap_update_time += elapsed();
+        sap.candidates(executor, vf_candidates, ee_candidates);
+        sweep_time += elapsed();
+
+        spatialHashCandidates(
+            executor, V0, V1, E, F, vf_candidates, ee_candidates);
+        hash_time += elapsed();
+
+        faceFaceCandidates(executor, V0, V1, F, ff_candidates);
+        face_pairs_time += elapsed();
+        triangles.candidates(
+            executor, ff_candidates, vf_candidates, ee_candidates);
+        expansion_time += elapsed();
+        num_face_pairs += ff_candidates.size();
+        num_representative += vf_candidates.size() + ee_candidates.size();
+    }
+    timer.stop();
+
+    const double n = args.num_frames;
+    const double num_boxes = double(vertex_boxes.size() + edge_boxes.size())
+        + double(face_boxes.size());
+    fmt::print("BVH build:        {:10.3f}ms\n", build_time);
+    fmt::print(
+        "Swept boxes:      {:10.3f}ms/frame ({:.1f}M boxes/s)\n",
+        boxes_time / n, 1e-3 * num_boxes * n / boxes_time);
+    fmt::print(
+        "BVH update:       {:10.3f}ms/frame ({:d} rebuilds, cost ratio "
+        "{:.2f})\n",
+        update_time / n, bvh.num_rebuilds(), bvh.cost_ratio());
+    fmt::print(
+        "BVH traversal:    {:10.3f}ms/frame ({:.1f}M candidates/s)\n",
+        traversal_time / n, 1e-3 * num_candidates / traversal_time);
+    fmt::print("SAP sort:         {:10.3f}ms\n", sort_time);
+    fmt::print(
+        "SAP update:       {:10.3f}ms/frame ({:.0f} swaps/frame, {:d} sorts "
+        "from scratch)\n",
+        sap_update_time / n, num_swaps / n, num_sorts);
+    fmt::print("SAP sweep:        {:10.3f}ms/frame\n", sweep_time / n);
+    fmt::print("Spatial hash:     {:10.3f}ms/frame\n", hash_time / n);
+    fmt::print("Face pairs:       {:10.3f}ms/frame\n", face_pairs_time / n);
+    // A pair of faces contains 6 vertex-face and 9 edge-edge pairs.
+    fmt::print(
+        "Representatives:  {:10.3f}ms/frame ({:.0f} pairs/frame instead of "
+        "{:.0f})\n",
+        expansion_time / n, num_representative / n, 15 * num_face_pairs / n);
+}
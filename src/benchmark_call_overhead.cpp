@@ -0,0 +1,127 @@
+// Time the per-call overhead of the scalar CCD functions
+//
+// Runs many cheap (mostly non-colliding) queries through vertexFaceCCD and
+// edgeEdgeCCD, so the cost of calling the wrapper is a large part of the
+// total. Build once with and once without CCD_WRAPPER_HEADER_ONLY to compare
+// the compiled and inlined adapters.
+
+#include <random>
+#include <vector>
+
+#include <CLI/CLI.hpp>
+#include <Eigen/Core>
+#include <fmt/format.h>
+
+#include <ccd.hpp>
+#include <utils/timer.hpp>
+
+using namespace ccd;
+
+struct CLIArgs {
+    int num_queries = 100'000;
+    int num_repeats = 10;
+    std::vector<CCDMethod> methods;
+
+    CLIArgs(int argc, char* argv[])
+    {
+        CLI::App app { "CCD Call Overhead Benchmark" };
+
+        std::vector<std::pair<std::string, CCDMethod>> name_to_method;
+        for (int i = 0; i < NUM_CCD_METHODS; i++) {
+            if (is_method_enabled(CCDMethod(i))) {
+                methods.push_back(CCDMethod(i));
+                name_to_method.emplace_back(method_names[i], CCDMethod(i));
+            }
+        }
+
+        app.add_option("-n,--num-queries", num_queries, "number of queries")
+            ->default_val(num_queries);
+        app.add_option("-r,--repeats", num_repeats, "number of repetitions")
+            ->default_val(num_repeats);
+        app.add_option("-m,--methods", methods, "CCD methods to benchmark")
+            ->transform(
+                CLI::CheckedTransformer(name_to_method, CLI::ignore_case))
+            ->default_val(methods);
+
+        try {
+            app.parse(argc, argv);
+        } catch (const CLI::ParseError& e) {
+            exit(app.exit(e));
+        }
+    }
+};
+
+// Random primitives in the unit cube moving by at most 0.1, so most queries
+// are rejected early by every method.
+std::vector<Eigen::Vector3d> random_queries(const int num_queries)
+{
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(0, 1);
+    std::uniform_real_distribution<double> displacement(-0.1, 0.1);
+
+    std::vector<Eigen::Vector3d> points(8 * num_queries);
+    for (int i = 0; i < num_queries; i++) {
+        for (int j = 0; j < 4; j++) {
+            Eigen::Vector3d& start = points[8 * i + j];
+            Eigen::Vector3d& end = points[8 * i + j + 4];
+            for (int k = 0; k < 3; k++) {
+                start[k] = position(gen);
+                end[k] = start[k] + displacement(gen);
+            }
+        }
+    }
+    return points;
+}
+
+// Average time per query in nanoseconds.
+template <typename Query>
+double time_queries(const CLIArgs& args, const Query& query, int& num_hits)
+{
+    Timer timer;
+    num_hits = 0;
+    timer.start();
+    for (int r = 0; r < args.num_repeats; r++) {
+        for (int i = 0; i < args.num_queries; i++) {
+            num_hits += query(i);
+        }
+    }
+    timer.stop();
+    return 1e3 * timer.getElapsedTimeInMicroSec()
+        / (double(args.num_queries) * args.num_repeats);
+}
+
+int main(int argc, char* argv[])
+{
+    const CLIArgs args(argc, argv);
+    const std::vector<Eigen::Vector3d> x = random_queries(args.num_queries);
+
+#ifdef CCD_WRAPPER_HEADER_ONLY
+    fmt::print("Adapters: header-only (CCD_WRAPPER_HEADER_ONLY=ON)\n\n");
+#else
+    fmt::print("Adapters: compiled (CCD_WRAPPER_HEADER_ONLY=OFF)\n\n");
+#endif
+
+    for (const CCDMethod method : args.methods) {
+        int num_vf_hits, num_ee_hits;
+        const double vf_time = time_queries(
+            args,
+            [&](const int i) {
+                const Eigen::Vector3d* q = &x[8 * i];
+                return vertexFaceCCD(
+                    q[0], q[1], q[2], q[3], q[4], q[5], q[6], q[7], method);
+            },
+            num_vf_hits);
+        const double ee_time = time_queries(
+            args,
+            [&](const int i) {
+                const Eigen::Vector3d* q = &x[8 * i];
+                return edgeEdgeCCD(
+                    q[0], q[1], q[2], q[3], q[4], q[5], q[6], q[7], method);
+            },
+            num_ee_hits);
+        fmt::print(
+            "{:<32s} vertex-face: {:8.1f}ns ({:d} hits)  "
+            "edge-edge: {:8.1f}ns ({:d} hits)\n",
+            method_names[method], vf_time, num_vf_hits, ee_time, num_ee_hits);
+    }
+}
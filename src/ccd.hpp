@@ -6,56 +6,50 @@
 
 #include <Eigen/Core>
 
-namespace ccd {
+#include <ccd_method.hpp>
 
-/// Methods of continuous collision detection.
-enum CCDMethod {
-    /// Etienne Vouga's CCD using a root finder in floating points
-    FLOATING_POINT_ROOT_FINDER = 0,
-    /// Floating-point root-finder minimum separation CCD of [Lu et al. 2018]
-    MIN_SEPARATION_ROOT_FINDER,
-    /// Root parity method of [Brochu et al. 2012]
-    ROOT_PARITY,
-    /// Teseo's reimplementation of [Brochu et al. 2012] using rationals
-    RATIONAL_ROOT_PARITY,
-    /// Root parity with and fixes
-    FLOATING_POINT_ROOT_PARITY,
-    /// Rational root parity with fixes
-    RATIONAL_FIXED_ROOT_PARITY,
-    /// Bernstein sign classification method of [Tang et al. 2014]
-    BSC,
-    /// TightCCD method of [Wang et al. 2015]
-    TIGHT_CCD,
-    // SafeCCD
-    SAFE_CCD,
-    /// Interval based CCD of [Redon et al. 2002]
-    UNIVARIATE_INTERVAL_ROOT_FINDER,
-    /// Interval based CCD of [Redon et al. 2002] solved using [Snyder 1992]
-    MULTIVARIATE_INTERVAL_ROOT_FINDER,
-    /// Custom inclusion based CCD of [Wang et al. 2020]
-    TIGHT_INCLUSION,
-    /// WARNING: Not a method! Counts the number of methods.
-    NUM_CCD_METHODS
-};
+// In the header-only build the functions below are defined inline in
+// ccd_impl.hpp instead of being compiled into the library.
+#ifdef CCD_WRAPPER_HEADER_ONLY
+#define CCD_WRAPPER_INLINE inline
+#else
+#define CCD_WRAPPER_INLINE
+#endif
 
-static const char* method_names[CCDMethod::NUM_CCD_METHODS] = {
-    "FloatingPointRootFinder",
-    "MinSeparationRootFinder",
-    "RootParity",
-    "RationalRootParity",
-    "FloatingPointRootParity",
-    "RationalFixedRootParity",
-    "BSC",
-    "TightCCD",
-    "SafeCCD",
-    "UnivariateIntervalRootFinder",
-    "MultivariateIntervalRootFinder",
-    "TightInclusion",
-};
+namespace ccd {
 
 /// Minimum separation distance used when looking for 0 distance collisions.
 static const double DEFAULT_MIN_DISTANCE = 1e-8;
 
+/// Result of a CCD query including the time of impact.
+struct CCDResult {
+    /// True if the primitives collide.
+    bool hit;
+    /// Time of impact in [0, 1] if the primitives collide, infinity otherwise.
+    /// Methods that do not compute a time of impact (see
+    /// is_time_of_impact_computed) conservatively report 0 on a hit.
+    double toi;
+    /// Tolerance actually achieved by Tight Inclusion (δ_actual) on a hit.
+    /// Zero for methods that do not report one. Unspecified on a miss: a miss
+    /// proven before running the method (e.g., by the swept box culling of
+    /// the batched functions) reports zero instead of the method's value.
+    double output_tolerance;
+};
+
+/// Outcome of a query of the noexcept CCD functions (e.g., tryVertexFaceCCD).
+enum class CCDStatus {
+    /// The query ran and found no collision.
+    OK,
+    /// The query ran and found a collision.
+    HIT,
+    /// The method is not enabled in this build.
+    DISABLED,
+    /// The method is invalid or the query failed (e.g., it threw).
+    FAILED,
+    /// A collision was found with a time of impact outside [0, 1].
+    TOI_OUT_OF_RANGE,
+};
+
 /**
  * @brief Detect collisions between a vertex and a triangular face.
  *
@@ -80,7 +74,32 @@ static const double DEFAULT_MIN_DISTANCE = 1e-8;
  *
  * @returns  True if the vertex and face collide.
  */
-bool vertexFaceCCD(
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const CCDMethod method,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect collisions between a vertex and a triangular face and compute
+ *        the time of impact.
+ *
+ * Same as above, but also returns the time of impact so positives do not
+ * have to be solved a second time.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns  True if the vertex and face collide.
+ */
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
     const Eigen::Vector3d& vertex_start,
     const Eigen::Vector3d& face_vertex0_start,
     const Eigen::Vector3d& face_vertex1_start,
@@ -90,6 +109,7 @@ bool vertexFaceCCD(
     const Eigen::Vector3d& face_vertex1_end,
     const Eigen::Vector3d& face_vertex2_end,
     const CCDMethod method,
+    CCDResult& result,
     const double tolerance = 1e-6,
     const long max_iter = 1'000'000,
     const Eigen::Array3d& err = { -1, 0, 0 });
@@ -120,7 +140,7 @@ bool vertexFaceCCD(
  *
  * @returns True if the edges collide.
  */
-bool edgeEdgeCCD(
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
     const Eigen::Vector3d& edge0_vertex0_start,
     const Eigen::Vector3d& edge0_vertex1_start,
     const Eigen::Vector3d& edge1_vertex0_start,
@@ -134,6 +154,32 @@ bool edgeEdgeCCD(
     const long max_iter = 1'000'000,
     const Eigen::Array3d& err = { -1, 0, 0 });
 
+/**
+ * @brief Detect collisions between two edges as they move and compute the time
+ *        of impact.
+ *
+ * Same as above, but also returns the time of impact so positives do not
+ * have to be solved a second time.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns True if the edges collide.
+ */
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
 /**
  * @brief Detect proximity collisions between a vertex and a triangular face.
  *
@@ -158,7 +204,7 @@ bool edgeEdgeCCD(
  *
  * @returns  True if the vertex and face collide.
  */
-bool vertexFaceMSCCD(
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
     const Eigen::Vector3d& vertex_start,
     const Eigen::Vector3d& face_vertex0_start,
     const Eigen::Vector3d& face_vertex1_start,
@@ -173,6 +219,33 @@ bool vertexFaceMSCCD(
     const long max_iter = 1'000'000,
     const Eigen::Array3d& err = { -1, 0, 0 });
 
+/**
+ * @brief Detect proximity collisions between a vertex and a triangular face
+ *        and compute the time of impact.
+ *
+ * Same as above, but also returns the time of impact so positives do not
+ * have to be solved a second time.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns  True if the vertex and face collide.
+ */
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
 /**
  * @brief Detect proximity collisions between two edges as they move.
  *
@@ -199,7 +272,33 @@ bool vertexFaceMSCCD(
  *
  * @returns True if the edges collide.
  */
-bool edgeEdgeMSCCD(
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect proximity collisions between two edges as they move and
+ *        compute the time of impact.
+ *
+ * Same as above, but also returns the time of impact so positives do not
+ * have to be solved a second time.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns True if the edges collide.
+ */
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
     const Eigen::Vector3d& edge0_vertex0_start,
     const Eigen::Vector3d& edge0_vertex1_start,
     const Eigen::Vector3d& edge1_vertex0_start,
@@ -210,15 +309,135 @@ bool edgeEdgeMSCCD(
     const Eigen::Vector3d& edge1_vertex1_end,
     const double min_distance,
     const CCDMethod method,
+    CCDResult& result,
     const double tolerance = 1e-6,
     const long max_iter = 1'000'000,
     const Eigen::Array3d& err = { -1, 0, 0 });
+
+////////////////////////////////////////////////////////////////////////////////
+// Noexcept versions
+//
+// These never throw and never write to std::cerr. Instead of printing a failure
+// and answering conservatively, they return a CCDStatus. On DISABLED, FAILED,
+// and TOI_OUT_OF_RANGE the result is filled conservatively (a hit at time 0).
+
+/**
+ * @brief Detect collisions between a vertex and a triangular face without
+ *        throwing.
+ *
+ * Same as vertexFaceCCD.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns Status of the query.
+ */
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 }) noexcept;
+
+/**
+ * @brief Detect collisions between two edges without throwing.
+ *
+ * Same as edgeEdgeCCD.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns Status of the query.
+ */
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 }) noexcept;
+
+/**
+ * @brief Detect proximity collisions between a vertex and a triangular face
+ *        without throwing.
+ *
+ * Same as vertexFaceMSCCD.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns Status of the query.
+ */
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 }) noexcept;
+
+/**
+ * @brief Detect proximity collisions between two edges without throwing.
+ *
+ * Same as edgeEdgeMSCCD.
+ *
+ * @param[out] result  Hit, time of impact, and achieved tolerance.
+ *
+ * @returns Status of the query.
+ */
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 }) noexcept;
 }
 
 namespace ccd {
-// float version
 
-bool vertexFaceCCD(
+////////////////////////////////////////////////////////////////////////////////
+// Single precision versions
+//
+// Every method accepts float points. Converting float to double is exact, so
+// methods without a single precision implementation answer the promoted query
+// with the same guarantees as the double versions (conservative methods stay
+// conservative, and a given err still bounds the rounding errors). Tight
+// Inclusion built without TIGHT_INCLUSION_WITH_DOUBLE_PRECISION runs natively
+// in float, and computes err = { -1, 0, 0 } for float arithmetic. In such a
+// build, double queries are rounded to float with the minimum separation
+// distance enlarged by the rounding error, so they stay conservative.
+
+/// Single precision version of vertexFaceCCD.
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
     const Eigen::Vector3f& vertex_start,
     const Eigen::Vector3f& face_vertex0_start,
     const Eigen::Vector3f& face_vertex1_start,
@@ -232,7 +451,40 @@ bool vertexFaceCCD(
     const long max_iter = 1'000'000,
     const Eigen::Array3f& err = { -1, 0, 0 });
 
-bool edgeEdgeCCD(
+/// Single precision version of vertexFaceCCD computing the time of impact.
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 });
+
+/// Single precision version of tryVertexFaceCCD.
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 }) noexcept;
+
+/// Single precision version of edgeEdgeCCD.
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
     const Eigen::Vector3f& edge0_vertex0_start,
     const Eigen::Vector3f& edge0_vertex1_start,
     const Eigen::Vector3f& edge1_vertex0_start,
@@ -246,7 +498,73 @@ bool edgeEdgeCCD(
     const long max_iter = 1'000'000,
     const Eigen::Array3f& err = { -1, 0, 0 });
 
-bool vertexFaceMSCCD(
+/// Single precision version of edgeEdgeCCD computing the time of impact.
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 });
+
+/// Single precision version of tryEdgeEdgeCCD.
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 }) noexcept;
+
+/// Single precision version of vertexFaceMSCCD.
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const float min_distance,
+    const CCDMethod method,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 });
+
+/// Single precision version of vertexFaceMSCCD computing the time of impact.
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const float min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 });
+
+/// Single precision version of tryVertexFaceMSCCD.
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceMSCCD(
     const Eigen::Vector3f& vertex_start,
     const Eigen::Vector3f& face_vertex0_start,
     const Eigen::Vector3f& face_vertex1_start,
@@ -257,11 +575,29 @@ bool vertexFaceMSCCD(
     const Eigen::Vector3f& face_vertex2_end,
     const float min_distance,
     const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 }) noexcept;
+
+/// Single precision version of edgeEdgeMSCCD.
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const float min_distance,
+    const CCDMethod method,
     const float tolerance = 1e-6f,
     const long max_iter = 1'000'000,
     const Eigen::Array3f& err = { -1, 0, 0 });
 
-bool edgeEdgeMSCCD(
+/// Single precision version of edgeEdgeMSCCD computing the time of impact.
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
     const Eigen::Vector3f& edge0_vertex0_start,
     const Eigen::Vector3f& edge0_vertex1_start,
     const Eigen::Vector3f& edge1_vertex0_start,
@@ -272,13 +608,31 @@ bool edgeEdgeMSCCD(
     const Eigen::Vector3f& edge1_vertex1_end,
     const float min_distance,
     const CCDMethod method,
+    CCDResult& result,
     const float tolerance = 1e-6f,
     const long max_iter = 1'000'000,
     const Eigen::Array3f& err = { -1, 0, 0 });
-}
+
+/// Single precision version of tryEdgeEdgeMSCCD.
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeMSCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const float min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance = 1e-6f,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3f& err = { -1, 0, 0 }) noexcept;
+} // namespace ccd
 
 namespace ccd{
-inline bool is_minimum_separation_method(const CCDMethod& method)
+constexpr bool is_minimum_separation_method(const CCDMethod& method)
 {
     switch (method) {
     case CCDMethod::MIN_SEPARATION_ROOT_FINDER:
@@ -289,7 +643,7 @@ inline bool is_minimum_separation_method(const CCDMethod& method)
     }
 }
 
-inline bool is_conservative_method(const CCDMethod& method)
+constexpr bool is_conservative_method(const CCDMethod& method)
 {
     switch (method) {
     // MIN_SEPARATION_ROOT_FINDER is conservative because minimum separation
@@ -299,13 +653,14 @@ inline bool is_conservative_method(const CCDMethod& method)
     case CCDMethod::UNIVARIATE_INTERVAL_ROOT_FINDER:
     case CCDMethod::MULTIVARIATE_INTERVAL_ROOT_FINDER:
     case CCDMethod::TIGHT_INCLUSION:
+    case CCDMethod::PRECISION_CASCADE:
         return true;
     default:
         return false;
     }
 }
 
-inline bool is_time_of_impact_computed(const CCDMethod& method)
+constexpr bool is_time_of_impact_computed(const CCDMethod& method)
 {
     switch (method) {
     case CCDMethod::FLOATING_POINT_ROOT_FINDER:
@@ -313,13 +668,14 @@ inline bool is_time_of_impact_computed(const CCDMethod& method)
     case CCDMethod::UNIVARIATE_INTERVAL_ROOT_FINDER:
     case CCDMethod::MULTIVARIATE_INTERVAL_ROOT_FINDER:
     case CCDMethod::TIGHT_INCLUSION:
+    case CCDMethod::PRECISION_CASCADE:
         return true;
     default:
         return false;
     }
 }
 
-inline bool is_method_enabled(const CCDMethod& method)
+constexpr bool is_method_enabled(const CCDMethod& method)
 {
     switch (method) {
     case FLOATING_POINT_ROOT_FINDER:
@@ -356,8 +712,17 @@ inline bool is_method_enabled(const CCDMethod& method)
     case TIGHT_INCLUSION:
         return CCD_WRAPPER_WITH_TIGHT_INCLUSION;
 
+    // Rational root parity is optional: without it, the positives Tight
+    // Inclusion cannot refine are answered conservatively.
+    case PRECISION_CASCADE:
+        return CCD_WRAPPER_WITH_TIGHT_INCLUSION;
+
     default:
         return false;
     }
 }
 } // namespace ccd
+
+#ifdef CCD_WRAPPER_HEADER_ONLY
+#include <ccd_impl.hpp>
+#endif
@@ -0,0 +1,56 @@
+// Culling of the candidates between adjacent primitives of a mesh
+#include "ccd_adjacency.hpp"
+
+#include <algorithm>
+
+namespace ccd {
+
+MeshAdjacency::MeshAdjacency(
+    const Eigen::MatrixXi& E, const Eigen::MatrixXi& F)
+    : edges(E.rows())
+    , faces(F.rows())
+    , edge_classes(E.rows(), 0)
+    , face_classes(F.rows(), 0)
+{
+    for (long e = 0; e < E.rows(); e++) {
+        for (int i = 0; i < 2; i++) {
+            edges[e][i] = E(e, i);
+            edge_classes[e] |= vertex_class(E(e, i));
+        }
+    }
+    for (long f = 0; f < F.rows(); f++) {
+        for (int i = 0; i < 3; i++) {
+            faces[f][i] = F(f, i);
+            face_classes[f] |= vertex_class(F(f, i));
+        }
+    }
+}
+
+void cullAdjacentCandidates(
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates)
+{
+    const MeshAdjacency adjacency(E, F);
+    const size_t num_vf = vf_candidates.size();
+    vf_candidates.erase(
+        std::remove_if(
+            vf_candidates.begin(), vf_candidates.end(),
+            [&](const VertexFaceCandidate& c) {
+                return adjacency.is_adjacent(c);
+            }),
+        vf_candidates.end());
+    const size_t num_ee = ee_candidates.size();
+    ee_candidates.erase(
+        std::remove_if(
+            ee_candidates.begin(), ee_candidates.end(),
+            [&](const EdgeEdgeCandidate& c) {
+                return adjacency.is_adjacent(c);
+            }),
+        ee_candidates.end());
+    kernels::AdjacencyCullingCounters::add(0, num_vf - vf_candidates.size());
+    kernels::AdjacencyCullingCounters::add(1, num_ee - ee_candidates.size());
+}
+
+} // namespace ccd
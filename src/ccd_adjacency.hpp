@@ -0,0 +1,153 @@
+/// @brief Culling of the candidates between adjacent primitives of a mesh
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_counters.hpp>
+#include <ccd_mesh.hpp>
+
+namespace ccd {
+
+/// Number of candidates dropped by the adjacency culling.
+struct AdjacencyCullingStats {
+    uint64_t num_vf_culled = 0; ///< Vertex-face pairs of a face's vertex.
+    uint64_t num_ee_culled = 0; ///< Edge-edge pairs sharing a vertex.
+};
+
+namespace kernels {
+
+    struct AdjacencyCullingTag;
+    using AdjacencyCullingCounters = Counters<AdjacencyCullingTag, 2>;
+
+    inline std::atomic<bool>& adjacency_culling_flag()
+    {
+        static std::atomic<bool> flag(true);
+        return flag;
+    }
+
+} // namespace kernels
+
+/**
+ * @brief Connectivity of a mesh answering whether two of its primitives share
+ *        a vertex.
+ *
+ * Each edge and face stores a 64-bit set of the classes (index modulo 64) of
+ * its vertices. Two primitives whose sets are disjoint share no vertex, which
+ * one AND of the sets proves for most pairs of a broad phase without reading
+ * the indices of the vertices. Only the pairs whose sets intersect compare
+ * the indices.
+ */
+class MeshAdjacency {
+public:
+    MeshAdjacency() = default;
+
+    /**
+     * @param[in] E  #E × 2 vertex indices of the edges.
+     * @param[in] F  #F × 3 vertex indices of the faces.
+     */
+    MeshAdjacency(const Eigen::MatrixXi& E, const Eigen::MatrixXi& F);
+
+    /// Whether the vertex is a vertex of the face.
+    bool is_adjacent(const long vertex_id, const long face_id) const
+    {
+        if ((vertex_class(vertex_id) & face_classes[face_id]) == 0) {
+            return false;
+        }
+        const std::array<int, 3>& face = faces[face_id];
+        return face[0] == vertex_id || face[1] == vertex_id
+            || face[2] == vertex_id;
+    }
+
+    /// Whether the vertex of a candidate is a vertex of its face.
+    bool is_adjacent(const VertexFaceCandidate& candidate) const
+    {
+        return is_adjacent(candidate.vertex_id, candidate.face_id);
+    }
+
+    /// Whether the edges of a candidate share a vertex.
+    bool is_adjacent(const EdgeEdgeCandidate& candidate) const
+    {
+        const long e0 = candidate.edge0_id, e1 = candidate.edge1_id;
+        if ((edge_classes[e0] & edge_classes[e1]) == 0) {
+            return false;
+        }
+        return edges[e0][0] == edges[e1][0] || edges[e0][0] == edges[e1][1]
+            || edges[e0][1] == edges[e1][0] || edges[e0][1] == edges[e1][1];
+    }
+
+private:
+    static uint64_t vertex_class(const long vertex_id)
+    {
+        return uint64_t(1) << (vertex_id & 63);
+    }
+
+    std::vector<std::array<int, 2>> edges;
+    std::vector<std::array<int, 3>> faces;
+    std::vector<uint64_t> edge_classes;
+    std::vector<uint64_t> face_classes;
+};
+
+/**
+ * @brief Remove the candidates between adjacent primitives of a mesh: the
+ *        vertex-face pairs of a vertex of the face, and the edge-edge pairs
+ *        of edges sharing a vertex.
+ *
+ * Such pairs are always in contact, so a self-collision broad phase would
+ * report them every time step, and the methods would report them as
+ * collisions. The broad phases of the wrapper already drop them when the
+ * adjacency culling is enabled.
+ *
+ * @param[in]     E              #E × 2 vertex indices of the edges.
+ * @param[in]     F              #F × 3 vertex indices of the faces.
+ * @param[in,out] vf_candidates  Vertex-face candidates of the mesh.
+ * @param[in,out] ee_candidates  Edge-edge candidates of the mesh.
+ */
+void cullAdjacentCandidates(
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates);
+
+/**
+ * @brief Enable or disable the adjacency culling of the self-collision broad
+ *        phases (spatialHashCandidates, MeshBVH, and SweepAndPrune).
+ *
+ * Enabled by default.
+ *
+ * @param[in] enabled  Whether to drop the candidates between adjacent
+ *                     primitives.
+ */
+inline void setAdjacencyCulling(const bool enabled)
+{
+    kernels::adjacency_culling_flag().store(enabled);
+}
+
+/// Whether the broad phases drop the candidates between adjacent primitives.
+inline bool isAdjacencyCullingEnabled()
+{
+    return kernels::adjacency_culling_flag().load();
+}
+
+/// Candidates dropped by the adjacency culling, summed over all threads since
+/// the last reset.
+inline AdjacencyCullingStats adjacencyCullingStats()
+{
+    AdjacencyCullingStats stats;
+    stats.num_vf_culled = kernels::AdjacencyCullingCounters::read(0);
+    stats.num_ee_culled = kernels::AdjacencyCullingCounters::read(1);
+    return stats;
+}
+
+/// Reset the statistics of the adjacency culling.
+inline void resetAdjacencyCullingStats()
+{
+    kernels::AdjacencyCullingCounters::reset();
+}
+
+} // namespace ccd
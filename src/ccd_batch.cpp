@@ -0,0 +1,289 @@
+// Batched CCD over contiguous arrays of queries
+#include "ccd_batch.hpp"
+
+#include "ccd_kernels.hpp"
+
+namespace ccd {
+
+namespace {
+
+    // Copy the points of the i-th packed query.
+    struct PackedGather {
+        const double* queries;
+
+        void operator()(const size_t i, Eigen::Vector3d x[8]) const
+        {
+            const double* query = queries + QUERY_SIZE * i;
+            for (int j = 0; j < 8; j++) {
+                x[j] = Eigen::Map<const Eigen::Vector3d>(query + 3 * j);
+            }
+        }
+    };
+
+} // namespace
+
+void vertexFaceCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::VertexFaceCCD>(
+        "Vertex-face", num_queries, method, PackedGather { queries }, hits,
+        tolerance, max_iter, err);
+}
+
+void vertexFaceCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::VertexFaceCCD>(
+        "Vertex-face", num_queries, method, PackedGather { queries }, results,
+        tolerance, max_iter, err);
+}
+
+void vertexFaceCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            vertexFaceCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, method, hits + begin,
+                tolerance, max_iter, err);
+        });
+}
+
+void vertexFaceCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            vertexFaceCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, method,
+                results + begin, tolerance, max_iter, err);
+        });
+}
+
+void edgeEdgeCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::EdgeEdgeCCD>(
+        "Edge-edge", num_queries, method, PackedGather { queries }, hits,
+        tolerance, max_iter, err);
+}
+
+void edgeEdgeCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::EdgeEdgeCCD>(
+        "Edge-edge", num_queries, method, PackedGather { queries }, results,
+        tolerance, max_iter, err);
+}
+
+void edgeEdgeCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            edgeEdgeCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, method, hits + begin,
+                tolerance, max_iter, err);
+        });
+}
+
+void edgeEdgeCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            edgeEdgeCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, method,
+                results + begin, tolerance, max_iter, err);
+        });
+}
+
+void vertexFaceMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::VertexFaceMSCCD>(
+        "Vertex-face", num_queries, method, PackedGather { queries }, hits,
+        min_distance, tolerance, max_iter, err);
+}
+
+void vertexFaceMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::VertexFaceMSCCD>(
+        "Vertex-face", num_queries, method, PackedGather { queries }, results,
+        min_distance, tolerance, max_iter, err);
+}
+
+void vertexFaceMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            vertexFaceMSCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, min_distance, method,
+                hits + begin, tolerance, max_iter, err);
+        });
+}
+
+void vertexFaceMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            vertexFaceMSCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, min_distance, method,
+                results + begin, tolerance, max_iter, err);
+        });
+}
+
+void edgeEdgeMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::EdgeEdgeMSCCD>(
+        "Edge-edge", num_queries, method, PackedGather { queries }, hits,
+        min_distance, tolerance, max_iter, err);
+}
+
+void edgeEdgeMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    kernels::run_batch<kernels::EdgeEdgeMSCCD>(
+        "Edge-edge", num_queries, method, PackedGather { queries }, results,
+        min_distance, tolerance, max_iter, err);
+}
+
+void edgeEdgeMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            edgeEdgeMSCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, min_distance, method,
+                hits + begin, tolerance, max_iter, err);
+        });
+}
+
+void edgeEdgeMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        num_queries, [&](const size_t begin, const size_t end) {
+            edgeEdgeMSCCDBatch(
+                queries + QUERY_SIZE * begin, end - begin, min_distance, method,
+                results + begin, tolerance, max_iter, err);
+        });
+}
+
+} // namespace ccd
@@ -0,0 +1,308 @@
+/// @brief Batched CCD over contiguous arrays of queries
+
+#pragma once
+
+#include <cstddef>
+
+#include <ccd.hpp>
+#include <ccd_executor.hpp>
+
+namespace ccd {
+
+/// Number of doubles in a packed query: eight 3D points stored row by row in
+/// the same order as the arguments of the scalar CCD functions.
+static const size_t QUERY_SIZE = 24;
+
+/**
+ * @brief Detect collisions for a batch of vertex-face queries.
+ *
+ * Equivalent to calling vertexFaceCCD on every query, but the method is
+ * dispatched once for the whole batch and the queries are evaluated in a
+ * single loop. Queries whose swept bounding boxes do not overlap are culled
+ * with SIMD instructions (see ccd_culling.hpp) and answered false without
+ * running the method.
+ *
+ * @param[in]  queries      Packed queries. Query i is the row-major 8x3 block
+ *                          starting at queries[QUERY_SIZE * i] with rows
+ *                          vertex_start, face_vertex0_start,
+ *                          face_vertex1_start, face_vertex2_start, vertex_end,
+ *                          face_vertex0_end, face_vertex1_end, and
+ *                          face_vertex2_end.
+ * @param[in]  num_queries  Number of queries.
+ * @param[in]  method       Method of exact CCD.
+ * @param[out] hits         Array of num_queries results. hits[i] is true if
+ *                          the i-th vertex and face collide.
+ */
+void vertexFaceCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of num_queries results of vertexFaceCCD.
+ */
+void vertexFaceCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the queries are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the queries.
+ */
+void vertexFaceCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the queries.
+ */
+void vertexFaceCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect collisions for a batch of edge-edge queries.
+ *
+ * Equivalent to calling edgeEdgeCCD on every query, but the method is
+ * dispatched once for the whole batch and the queries are evaluated in a
+ * single loop. Queries whose swept bounding boxes do not overlap are culled
+ * with SIMD instructions (see ccd_culling.hpp) and answered false without
+ * running the method.
+ *
+ * @param[in]  queries      Packed queries. Query i is the row-major 8x3 block
+ *                          starting at queries[QUERY_SIZE * i] with rows
+ *                          edge0_vertex0_start, edge0_vertex1_start,
+ *                          edge1_vertex0_start, edge1_vertex1_start,
+ *                          edge0_vertex0_end, edge0_vertex1_end,
+ *                          edge1_vertex0_end, and edge1_vertex1_end.
+ * @param[in]  num_queries  Number of queries.
+ * @param[in]  method       Method of exact CCD.
+ * @param[out] hits         Array of num_queries results. hits[i] is true if
+ *                          the i-th pair of edges collide.
+ */
+void edgeEdgeCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of num_queries results of edgeEdgeCCD.
+ */
+void edgeEdgeCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the queries are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the queries.
+ */
+void edgeEdgeCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the queries.
+ */
+void edgeEdgeCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect proximity collisions for a batch of vertex-face queries.
+ *
+ * Batched version of vertexFaceMSCCD. See vertexFaceCCDBatch for the layout
+ * of the queries.
+ *
+ * @param[in]  queries       Packed queries.
+ * @param[in]  num_queries   Number of queries.
+ * @param[in]  min_distance  Minimum separation distance.
+ * @param[in]  method        Method of minimum separation CCD.
+ * @param[out] hits          Array of num_queries results.
+ */
+void vertexFaceMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of num_queries results of vertexFaceMSCCD.
+ */
+void vertexFaceMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the queries are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the queries.
+ */
+void vertexFaceMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the queries.
+ */
+void vertexFaceMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect proximity collisions for a batch of edge-edge queries.
+ *
+ * Batched version of edgeEdgeMSCCD. See edgeEdgeCCDBatch for the layout of
+ * the queries.
+ *
+ * @param[in]  queries       Packed queries.
+ * @param[in]  num_queries   Number of queries.
+ * @param[in]  min_distance  Minimum separation distance.
+ * @param[in]  method        Method of minimum separation CCD.
+ * @param[out] hits          Array of num_queries results.
+ */
+void edgeEdgeMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of num_queries results of edgeEdgeMSCCD.
+ */
+void edgeEdgeMSCCDBatch(
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the queries are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the queries.
+ */
+void edgeEdgeMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the queries.
+ */
+void edgeEdgeMSCCDBatch(
+    Executor& executor,
+    const double* queries,
+    const size_t num_queries,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+} // namespace ccd
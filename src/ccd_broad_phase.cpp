@@ -0,0 +1,168 @@
+// Swept bounding boxes shared by the broad phases
+#include "ccd_broad_phase.hpp"
+
+#include <algorithm>
+#include <tuple>
+
+namespace ccd {
+
+namespace {
+
+    // Swept box of a primitive given the indices of its vertices
+    template <typename Indices>
+    SweptBox swept_box(
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Indices& vertices,
+        const double inflation_radius)
+    {
+        SweptBox box;
+        box.min = V0.row(vertices(0)).transpose().array();
+        box.max = box.min;
+        for (long i = 0; i < long(vertices.size()); i++) {
+            const Eigen::Array3d p0 = V0.row(vertices(i)).transpose().array();
+            const Eigen::Array3d p1 = V1.row(vertices(i)).transpose().array();
+            box.min = box.min.min(p0).min(p1);
+            box.max = box.max.max(p0).max(p1);
+        }
+        box.min -= inflation_radius;
+        box.max += inflation_radius;
+        return box;
+    }
+
+} // namespace
+
+namespace broad_phase {
+
+    void swept_boxes(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const double inflation_radius,
+        std::vector<SweptBox>& vertex_boxes,
+        std::vector<SweptBox>& edge_boxes,
+        std::vector<SweptBox>& face_boxes)
+    {
+        vertex_boxes.resize(V0.rows());
+        edge_boxes.resize(E.rows());
+        face_boxes.resize(F.rows());
+        parallel_for(
+            executor, vertex_boxes.size(),
+            [&](const size_t begin, const size_t end) {
+                for (size_t v = begin; v < end; v++) {
+                    const Eigen::Array3d p0 = V0.row(v).transpose().array();
+                    const Eigen::Array3d p1 = V1.row(v).transpose().array();
+                    vertex_boxes[v].min = p0.min(p1) - inflation_radius;
+                    vertex_boxes[v].max = p0.max(p1) + inflation_radius;
+                }
+            });
+        parallel_for(
+            executor, edge_boxes.size(),
+            [&](const size_t begin, const size_t end) {
+                for (size_t e = begin; e < end; e++) {
+                    edge_boxes[e] =
+                        swept_box(V0, V1, E.row(e), inflation_radius);
+                }
+            });
+        parallel_for(
+            executor, face_boxes.size(),
+            [&](const size_t begin, const size_t end) {
+                for (size_t f = begin; f < end; f++) {
+                    face_boxes[f] =
+                        swept_box(V0, V1, F.row(f), inflation_radius);
+                }
+            });
+    }
+
+    void sort_candidates(std::vector<VertexFaceCandidate>& candidates)
+    {
+        const auto key = [](const VertexFaceCandidate& c) {
+            return std::make_tuple(c.vertex_id, c.face_id);
+        };
+        std::sort(
+            candidates.begin(), candidates.end(),
+            [&](const VertexFaceCandidate& a, const VertexFaceCandidate& b) {
+                return key(a) < key(b);
+            });
+        candidates.erase(
+            std::unique(
+                candidates.begin(), candidates.end(),
+                [&](const VertexFaceCandidate& a,
+                    const VertexFaceCandidate& b) { return key(a) == key(b); }),
+            candidates.end());
+    }
+
+    void sort_candidates(std::vector<EdgeEdgeCandidate>& candidates)
+    {
+        const auto key = [](const EdgeEdgeCandidate& c) {
+            return std::make_tuple(c.edge0_id, c.edge1_id);
+        };
+        std::sort(
+            candidates.begin(), candidates.end(),
+            [&](const EdgeEdgeCandidate& a, const EdgeEdgeCandidate& b) {
+                return key(a) < key(b);
+            });
+        candidates.erase(
+            std::unique(
+                candidates.begin(), candidates.end(),
+                [&](const EdgeEdgeCandidate& a, const EdgeEdgeCandidate& b) {
+                    return key(a) == key(b);
+                }),
+            candidates.end());
+    }
+
+    void sort_candidates(std::vector<FaceFaceCandidate>& candidates)
+    {
+        const auto key = [](const FaceFaceCandidate& c) {
+            return std::make_tuple(c.face0_id, c.face1_id);
+        };
+        std::sort(
+            candidates.begin(), candidates.end(),
+            [&](const FaceFaceCandidate& a, const FaceFaceCandidate& b) {
+                return key(a) < key(b);
+            });
+        candidates.erase(
+            std::unique(
+                candidates.begin(), candidates.end(),
+                [&](const FaceFaceCandidate& a, const FaceFaceCandidate& b) {
+                    return key(a) == key(b);
+                }),
+            candidates.end());
+    }
+
+} // namespace broad_phase
+
+void sweptBoxes(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius,
+    std::vector<SweptBox>& vertex_boxes,
+    std::vector<SweptBox>& edge_boxes,
+    std::vector<SweptBox>& face_boxes)
+{
+    broad_phase::swept_boxes(
+        /*executor=*/nullptr, V0, V1, E, F, inflation_radius, vertex_boxes,
+        edge_boxes, face_boxes);
+}
+
+void sweptBoxes(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius,
+    std::vector<SweptBox>& vertex_boxes,
+    std::vector<SweptBox>& edge_boxes,
+    std::vector<SweptBox>& face_boxes)
+{
+    broad_phase::swept_boxes(
+        &executor, V0, V1, E, F, inflation_radius, vertex_boxes, edge_boxes,
+        face_boxes);
+}
+
+} // namespace ccd
@@ -0,0 +1,155 @@
+/// @brief Swept bounding boxes shared by the broad phases
+
+#pragma once
+
+#include <mutex>
+#include <type_traits>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_adjacency.hpp>
+#include <ccd_executor.hpp>
+#include <ccd_mesh.hpp>
+
+namespace ccd {
+
+/// Axis-aligned bounding box swept by a primitive during a time step.
+struct SweptBox {
+    Eigen::Array3d min; ///< Minimum corner
+    Eigen::Array3d max; ///< Maximum corner
+
+    /// Whether the box intersects another one (closed boxes).
+    bool intersects(const SweptBox& other) const
+    {
+        return (min <= other.max).all() && (other.min <= max).all();
+    }
+};
+
+/// Candidate pair of faces of a mesh
+struct FaceFaceCandidate {
+    long face0_id; ///< Index of the first face
+    long face1_id; ///< Index of the second face
+};
+
+/**
+ * @brief Compute the swept bounding boxes of the vertices, edges, and faces
+ *        of a moving mesh.
+ *
+ * The points move linearly, so the box of a primitive is the bounding box of
+ * its start and end points.
+ *
+ * @param[in]  V0                #V × 3 vertex positions at the start.
+ * @param[in]  V1                #V × 3 vertex positions at the end.
+ * @param[in]  E                 #E × 2 vertex indices of the edges.
+ * @param[in]  F                 #F × 3 vertex indices of the faces.
+ * @param[in]  inflation_radius  Distance by which the boxes are inflated
+ *                               (e.g., the minimum separation distance).
+ * @param[out] vertex_boxes      #V boxes of the vertices.
+ * @param[out] edge_boxes        #E boxes of the edges.
+ * @param[out] face_boxes        #F boxes of the faces.
+ */
+void sweptBoxes(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius,
+    std::vector<SweptBox>& vertex_boxes,
+    std::vector<SweptBox>& edge_boxes,
+    std::vector<SweptBox>& face_boxes);
+
+/// Same as above, but the boxes are computed by the threads of an executor.
+void sweptBoxes(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius,
+    std::vector<SweptBox>& vertex_boxes,
+    std::vector<SweptBox>& edge_boxes,
+    std::vector<SweptBox>& face_boxes);
+
+namespace broad_phase {
+
+    /// Run body(begin, end) over [0, n), in parallel if there is an executor.
+    template <typename Body>
+    void parallel_for(Executor* executor, const size_t n, Body&& body)
+    {
+        if (executor != nullptr) {
+            executor->parallel_for(n, body);
+        } else if (n > 0) {
+            body(size_t(0), n);
+        }
+    }
+
+    /// Swept boxes of a mesh, computed in parallel if there is an executor.
+    void swept_boxes(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const double inflation_radius,
+        std::vector<SweptBox>& vertex_boxes,
+        std::vector<SweptBox>& edge_boxes,
+        std::vector<SweptBox>& face_boxes);
+
+    /// Sort candidates and remove the duplicates, so that the output of a
+    /// broad phase does not depend on the order its threads found them. The
+    /// edges of an edge-edge candidate must be in increasing order.
+    void sort_candidates(std::vector<VertexFaceCandidate>& candidates);
+    void sort_candidates(std::vector<EdgeEdgeCandidate>& candidates);
+    void sort_candidates(std::vector<FaceFaceCandidate>& candidates);
+
+    /// Connectivity used to cull the pairs of a self-collision broad phase,
+    /// or null if the adjacency culling is disabled.
+    inline const MeshAdjacency* culling(const MeshAdjacency& adjacency)
+    {
+        return isAdjacencyCullingEnabled() ? &adjacency : nullptr;
+    }
+
+    /// Whether a pair is between adjacent primitives and is dropped, counting
+    /// it in the statistics of the adjacency culling.
+    template <typename Candidate>
+    bool is_culled(const MeshAdjacency* adjacency, const Candidate& candidate)
+    {
+        if (adjacency == nullptr || !adjacency->is_adjacent(candidate)) {
+            return false;
+        }
+        kernels::AdjacencyCullingCounters::increment(
+            std::is_same<Candidate, VertexFaceCandidate>::value ? 0 : 1);
+        return true;
+    }
+
+    /**
+     * @brief Gather the candidates found by find(i, found) for all i in
+     *        [0, n), in parallel if there is an executor.
+     *
+     * Each chunk of indices pushes to its own vector, which is appended to
+     * the candidates under a lock. The candidates are then sorted.
+     */
+    template <typename Candidate, typename Find>
+    void gather_candidates(
+        Executor* executor,
+        const size_t n,
+        std::vector<Candidate>& candidates,
+        Find&& find)
+    {
+        candidates.clear();
+        std::mutex mutex;
+        parallel_for(executor, n, [&](const size_t begin, const size_t end) {
+            std::vector<Candidate> found;
+            for (size_t i = begin; i < end; i++) {
+                find(i, found);
+            }
+            std::lock_guard<std::mutex> lock(mutex);
+            candidates.insert(candidates.end(), found.begin(), found.end());
+        });
+        sort_candidates(candidates);
+    }
+
+} // namespace broad_phase
+
+} // namespace ccd
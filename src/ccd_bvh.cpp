@@ -0,0 +1,318 @@
+// Bounding volume hierarchy broad phase refitted every time step
+#include "ccd_bvh.hpp"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+namespace ccd {
+
+namespace {
+
+    // Largest number of primitives of a leaf
+    const int LEAF_SIZE = 4;
+
+    SweptBox merge(const SweptBox& a, const SweptBox& b)
+    {
+        return { a.min.min(b.min), a.max.max(b.max) };
+    }
+
+    double surface_area(const SweptBox& box)
+    {
+        const Eigen::Array3d d = box.max - box.min;
+        return 2 * (d[0] * d[1] + d[1] * d[2] + d[2] * d[0]);
+    }
+
+} // namespace
+
+namespace broad_phase {
+
+    void BoxTree::build(const std::vector<SweptBox>& primitive_boxes)
+    {
+        nodes.clear();
+        levels.clear();
+        ids.resize(primitive_boxes.size());
+        std::iota(ids.begin(), ids.end(), 0);
+        // The boxes are indexed by primitive while building, then reordered.
+        boxes = primitive_boxes;
+        if (!boxes.empty()) {
+            nodes.reserve(2 * boxes.size() / LEAF_SIZE + 1);
+            build(0, int(boxes.size()), 0);
+        }
+        for (size_t i = 0; i < ids.size(); i++) {
+            boxes[i] = primitive_boxes[ids[i]];
+        }
+    }
+
+    int BoxTree::build(const int begin, const int end, const int depth)
+    {
+        const int node = int(nodes.size());
+        nodes.push_back({ boxes[ids[begin]], begin, end - begin });
+        if (levels.size() <= size_t(depth)) {
+            levels.resize(depth + 1);
+        }
+        levels[depth].push_back(node);
+
+        Eigen::Array3d centroid_min = Eigen::Array3d::Constant(
+            std::numeric_limits<double>::infinity());
+        Eigen::Array3d centroid_max = -centroid_min;
+        for (int i = begin; i < end; i++) {
+            const SweptBox& box = boxes[ids[i]];
+            nodes[node].box = merge(nodes[node].box, box);
+            centroid_min = centroid_min.min(box.min + box.max);
+            centroid_max = centroid_max.max(box.min + box.max);
+        }
+        if (end - begin <= LEAF_SIZE) {
+            return node;
+        }
+
+        int axis;
+        (centroid_max - centroid_min).maxCoeff(&axis);
+        const int middle = begin + (end - begin) / 2;
+        std::nth_element(
+            ids.begin() + begin, ids.begin() + middle, ids.begin() + end,
+            [&](const long a, const long b) {
+                return boxes[a].min[axis] + boxes[a].max[axis]
+                    < boxes[b].min[axis] + boxes[b].max[axis];
+            });
+        build(begin, middle, depth + 1); // Left child at node + 1
+        const int right = build(middle, end, depth + 1);
+        nodes[node].first = right;
+        nodes[node].count = 0;
+        return node;
+    }
+
+    void BoxTree::refit(
+        Executor* executor, const std::vector<SweptBox>& primitive_boxes)
+    {
+        parallel_for(
+            executor, ids.size(), [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    boxes[i] = primitive_boxes[ids[i]];
+                }
+            });
+        // The children of the nodes of a level are in the deeper levels.
+        for (auto level = levels.rbegin(); level != levels.rend(); level++) {
+            parallel_for(
+                executor, level->size(),
+                [&](const size_t begin, const size_t end) {
+                    for (size_t i = begin; i < end; i++) {
+                        Node& node = nodes[(*level)[i]];
+                        if (node.count > 0) {
+                            node.box = boxes[node.first];
+                            for (int j = 1; j < node.count; j++) {
+                                node.box =
+                                    merge(node.box, boxes[node.first + j]);
+                            }
+                        } else {
+                            node.box = merge(
+                                nodes[(*level)[i] + 1].box,
+                                nodes[node.first].box);
+                        }
+                    }
+                });
+        }
+    }
+
+    double BoxTree::cost() const
+    {
+        if (nodes.empty()) {
+            return 0;
+        }
+        double area = 0;
+        for (const Node& node : nodes) {
+            area += surface_area(node.box);
+        }
+        const double root_area = surface_area(nodes[0].box);
+        return root_area > 0 ? area / root_area : 0;
+    }
+
+} // namespace broad_phase
+
+void MeshBVH::build(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius)
+{
+    edges = E;
+    faces = F;
+    adjacency = MeshAdjacency(E, F);
+    build(/*executor=*/nullptr, V0, V1, inflation_radius);
+}
+
+void MeshBVH::build(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius)
+{
+    edges = E;
+    faces = F;
+    adjacency = MeshAdjacency(E, F);
+    build(&executor, V0, V1, inflation_radius);
+}
+
+void MeshBVH::build(
+    Executor* executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    broad_phase::swept_boxes(
+        executor, V0, V1, edges, faces, inflation_radius, vertex_boxes,
+        edge_boxes, face_boxes);
+    vertex_tree.build(vertex_boxes);
+    edge_tree.build(edge_boxes);
+    face_tree.build(face_boxes);
+    built_cost = vertex_tree.cost() + edge_tree.cost() + face_tree.cost();
+    rebuilds = 0;
+}
+
+bool MeshBVH::update(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    return update(/*executor=*/nullptr, V0, V1, inflation_radius);
+}
+
+bool MeshBVH::update(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    return update(&executor, V0, V1, inflation_radius);
+}
+
+bool MeshBVH::update(
+    Executor* executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    broad_phase::swept_boxes(
+        executor, V0, V1, edges, faces, inflation_radius, vertex_boxes,
+        edge_boxes, face_boxes);
+    vertex_tree.refit(executor, vertex_boxes);
+    edge_tree.refit(executor, edge_boxes);
+    face_tree.refit(executor, face_boxes);
+    if (cost_ratio() <= rebuild_threshold) {
+        return false;
+    }
+
+    vertex_tree.build(vertex_boxes);
+    edge_tree.build(edge_boxes);
+    face_tree.build(face_boxes);
+    built_cost = vertex_tree.cost() + edge_tree.cost() + face_tree.cost();
+    rebuilds++;
+    return true;
+}
+
+double MeshBVH::cost_ratio() const
+{
+    const double cost =
+        vertex_tree.cost() + edge_tree.cost() + face_tree.cost();
+    return built_cost > 0 ? cost / built_cost : 1;
+}
+
+void MeshBVH::candidates(
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(/*executor=*/nullptr, vf_candidates, ee_candidates);
+}
+
+void MeshBVH::candidates(
+    Executor& executor,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(&executor, vf_candidates, ee_candidates);
+}
+
+void MeshBVH::candidates(
+    Executor* executor,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    const MeshAdjacency* culled = broad_phase::culling(adjacency);
+    broad_phase::gather_candidates(
+        executor, vertex_boxes.size(), vf_candidates,
+        [&](const size_t v, std::vector<VertexFaceCandidate>& found) {
+            face_tree.query(vertex_boxes[v], [&](const long f) {
+                const VertexFaceCandidate candidate { long(v), f };
+                if (!broad_phase::is_culled(culled, candidate)) {
+                    found.push_back(candidate);
+                }
+            });
+        });
+    broad_phase::gather_candidates(
+        executor, edge_boxes.size(), ee_candidates,
+        [&](const size_t e0, std::vector<EdgeEdgeCandidate>& found) {
+            edge_tree.query(edge_boxes[e0], [&](const long e1) {
+                const EdgeEdgeCandidate candidate { long(e0), e1 };
+                if (e1 > long(e0)
+                    && !broad_phase::is_culled(culled, candidate)) {
+                    found.push_back(candidate);
+                }
+            });
+        });
+}
+
+void MeshBVH::candidates(
+    const MeshBVH& other,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<VertexFaceCandidate>& fv_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(
+        /*executor=*/nullptr, other, vf_candidates, fv_candidates,
+        ee_candidates);
+}
+
+void MeshBVH::candidates(
+    Executor& executor,
+    const MeshBVH& other,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<VertexFaceCandidate>& fv_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(&executor, other, vf_candidates, fv_candidates, ee_candidates);
+}
+
+void MeshBVH::candidates(
+    Executor* executor,
+    const MeshBVH& other,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<VertexFaceCandidate>& fv_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    broad_phase::gather_candidates(
+        executor, vertex_boxes.size(), vf_candidates,
+        [&](const size_t v, std::vector<VertexFaceCandidate>& found) {
+            other.face_tree.query(vertex_boxes[v], [&](const long f) {
+                found.push_back({ long(v), f });
+            });
+        });
+    broad_phase::gather_candidates(
+        executor, other.vertex_boxes.size(), fv_candidates,
+        [&](const size_t v, std::vector<VertexFaceCandidate>& found) {
+            face_tree.query(other.vertex_boxes[v], [&](const long f) {
+                found.push_back({ long(v), f });
+            });
+        });
+    broad_phase::gather_candidates(
+        executor, edge_boxes.size(), ee_candidates,
+        [&](const size_t e0, std::vector<EdgeEdgeCandidate>& found) {
+            other.edge_tree.query(edge_boxes[e0], [&](const long e1) {
+                found.push_back({ long(e0), e1 });
+            });
+        });
+}
+
+} // namespace ccd
@@ -0,0 +1,242 @@
+/// @brief Bounding volume hierarchy broad phase refitted every time step
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_broad_phase.hpp>
+
+namespace ccd {
+
+namespace broad_phase {
+
+    /**
+     * @brief Hierarchy of boxes stored as a flat array of nodes in
+     *        depth-first order.
+     *
+     * The left child of an internal node follows it, and the boxes of the
+     * primitives are stored in the order of the leaves, so that a traversal
+     * reads memory mostly forward.
+     */
+    class BoxTree {
+    public:
+        /// Build the hierarchy with median splits along the longest axis.
+        void build(const std::vector<SweptBox>& primitive_boxes);
+
+        /// Update the boxes of the nodes to new boxes of the same primitives,
+        /// one level at a time from the leaves, in parallel if there is an
+        /// executor.
+        void refit(
+            Executor* executor, const std::vector<SweptBox>& primitive_boxes);
+
+        /// Total surface area of the nodes relative to the one of the root,
+        /// which estimates the cost of a traversal.
+        double cost() const;
+
+        /// Call f(id) for every primitive whose box intersects a box.
+        template <typename F> void query(const SweptBox& box, F&& f) const
+        {
+            if (nodes.empty()) {
+                return;
+            }
+            int stack[64];
+            int size = 0;
+            stack[size++] = 0;
+            while (size > 0) {
+                const Node& node = nodes[stack[--size]];
+                if (!node.box.intersects(box)) {
+                    continue;
+                }
+                if (node.count > 0) {
+                    for (int i = node.first; i < node.first + node.count;
+                         i++) {
+                        if (boxes[i].intersects(box)) {
+                            f(ids[i]);
+                        }
+                    }
+                } else {
+                    stack[size++] = node.first; // Right child
+                    stack[size++] = int(&node - nodes.data()) + 1;
+                }
+            }
+        }
+
+    private:
+        struct Node {
+            SweptBox box;
+            /// First primitive of a leaf, or right child of an internal node
+            int first;
+            /// Number of primitives of a leaf, or zero
+            int count;
+        };
+
+        int build(int begin, int end, int depth);
+
+        std::vector<Node> nodes;
+        /// Boxes of the primitives in the order of the leaves
+        std::vector<SweptBox> boxes;
+        /// Primitives in the order of the leaves
+        std::vector<long> ids;
+        /// Nodes at each depth
+        std::vector<std::vector<int>> levels;
+    };
+
+} // namespace broad_phase
+
+/**
+ * @brief Bounding volume hierarchies of the swept boxes of the vertices,
+ *        edges, and faces of a mesh with a fixed topology.
+ *
+ * Build the hierarchies once, then update them every time step. An update
+ * refits the boxes of the nodes to the new positions in parallel. Refitting
+ * keeps the structure of the hierarchies, whose quality degrades as the mesh
+ * deforms, so an update rebuilds them once the cost of a traversal grows by
+ * more than rebuild_threshold since the last build.
+ *
+ * The candidates of the mesh against itself skip the pairs of adjacent
+ * primitives if the adjacency culling is enabled (see setAdjacencyCulling).
+ * They can be passed to the mesh functions (e.g., meshVertexFaceCCD).
+ */
+class MeshBVH {
+public:
+    /// Ratio of the cost of the refitted hierarchies to their cost after the
+    /// last build above which update rebuilds them.
+    double rebuild_threshold = 2;
+
+    /**
+     * @brief Build the hierarchies of a moving mesh.
+     *
+     * @param[in] V0                #V × 3 vertex positions at the start.
+     * @param[in] V1                #V × 3 vertex positions at the end.
+     * @param[in] E                 #E × 2 vertex indices of the edges.
+     * @param[in] F                 #F × 3 vertex indices of the faces.
+     * @param[in] inflation_radius  Distance by which the boxes are inflated
+     *                              (e.g., the minimum separation distance).
+     */
+    void build(
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const double inflation_radius = 0);
+
+    /// Same as above, but the boxes are computed by the threads of an
+    /// executor.
+    void build(
+        Executor& executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const double inflation_radius = 0);
+
+    /**
+     * @brief Refit the hierarchies to new positions of the mesh, and rebuild
+     *        them if their quality degraded.
+     *
+     * @param[in] V0                #V × 3 vertex positions at the start.
+     * @param[in] V1                #V × 3 vertex positions at the end.
+     * @param[in] inflation_radius  Distance by which the boxes are inflated.
+     *
+     * @returns Whether the hierarchies were rebuilt.
+     */
+    bool update(
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius = 0);
+
+    /// Same as above, but the hierarchies are refitted by the threads of an
+    /// executor.
+    bool update(
+        Executor& executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius = 0);
+
+    /**
+     * @brief Find the candidate pairs of primitives of the mesh.
+     *
+     * @param[out] vf_candidates  Vertex-face pairs whose boxes intersect.
+     * @param[out] ee_candidates  Pairs of distinct edges whose boxes
+     *                            intersect, with edge0_id < edge1_id.
+     */
+    void candidates(
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /// Same as above, but the hierarchies are traversed by the threads of an
+    /// executor.
+    void candidates(
+        Executor& executor,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /**
+     * @brief Find the candidate pairs of primitives between this mesh and
+     *        another one.
+     *
+     * @param[in]  other          Hierarchies of the other mesh.
+     * @param[out] vf_candidates  Pairs of a vertex of this mesh and a face of
+     *                            the other one whose boxes intersect.
+     * @param[out] fv_candidates  Pairs of a vertex of the other mesh and a
+     *                            face of this one whose boxes intersect.
+     * @param[out] ee_candidates  Pairs of an edge of this mesh (edge0_id) and
+     *                            an edge of the other one (edge1_id) whose
+     *                            boxes intersect.
+     */
+    void candidates(
+        const MeshBVH& other,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<VertexFaceCandidate>& fv_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /// Same as above, but the hierarchies are traversed by the threads of an
+    /// executor.
+    void candidates(
+        Executor& executor,
+        const MeshBVH& other,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<VertexFaceCandidate>& fv_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /// Cost of a traversal of the hierarchies relative to the one after the
+    /// last build (see rebuild_threshold).
+    double cost_ratio() const;
+
+    /// Number of times update rebuilt the hierarchies since build.
+    size_t num_rebuilds() const { return rebuilds; }
+
+private:
+    void build(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius);
+    bool update(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius);
+    void candidates(
+        Executor* executor,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+    void candidates(
+        Executor* executor,
+        const MeshBVH& other,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<VertexFaceCandidate>& fv_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    Eigen::MatrixXi edges, faces;
+    MeshAdjacency adjacency;
+    std::vector<SweptBox> vertex_boxes, edge_boxes, face_boxes;
+    broad_phase::BoxTree vertex_tree, edge_tree, face_tree;
+    double built_cost = 0;
+    size_t rebuilds = 0;
+};
+
+} // namespace ccd
@@ -0,0 +1,78 @@
+/// @brief Statistics of the precision cascade (CCDMethod::PRECISION_CASCADE)
+
+#pragma once
+
+#include <cstdint>
+
+#include <ccd_counters.hpp>
+
+namespace ccd {
+
+/// Tiers of the precision cascade, from the cheapest to the most expensive.
+enum CascadeTier {
+    /// Tight Inclusion with a coarse tolerance and a small iteration budget
+    COARSE_TIGHT_INCLUSION_TIER = 0,
+    /// Tight Inclusion with the tolerance and iteration budget of the query
+    TIGHT_INCLUSION_TIER,
+    /// Rational root parity
+    RATIONAL_ROOT_PARITY_TIER,
+    /// WARNING: Not a tier! Counts the number of tiers.
+    NUM_CASCADE_TIERS
+};
+
+/// Tolerance of the coarse tier. Queries with a coarser tolerance use theirs.
+static const double CASCADE_COARSE_TOLERANCE = 1e-3;
+
+/// Iteration budget of the coarse tier. Queries with a smaller budget use
+/// theirs.
+static const long CASCADE_COARSE_MAX_ITER = 1000;
+
+/// Number of queries the precision cascade resolved at each tier.
+struct CascadeStats {
+    uint64_t num_queries = 0; ///< Queries run by the cascade.
+    /// Queries answered by each tier.
+    uint64_t num_resolved[NUM_CASCADE_TIERS] = {};
+    /// Positive queries Tight Inclusion could not refine to the tolerance and
+    /// rational root parity could not check (disabled or failed). They are
+    /// answered conservatively with the Tight Inclusion result.
+    uint64_t num_unresolved = 0;
+
+    /// Fraction of the queries resolved at a tier.
+    double resolved_rate(const CascadeTier tier) const
+    {
+        return num_queries > 0
+            ? double(num_resolved[tier]) / double(num_queries)
+            : 0.0;
+    }
+};
+
+namespace kernels {
+
+    struct CascadeTag;
+    // Counts of the tiers, the unresolved queries, and the queries.
+    using CascadeCounters = Counters<CascadeTag, NUM_CASCADE_TIERS + 2>;
+
+    static const size_t CASCADE_UNRESOLVED = NUM_CASCADE_TIERS;
+    static const size_t CASCADE_QUERIES = NUM_CASCADE_TIERS + 1;
+
+} // namespace kernels
+
+/// Queries resolved at each tier of the precision cascade, summed over all
+/// threads since the last reset.
+inline CascadeStats precisionCascadeStats()
+{
+    CascadeStats stats;
+    stats.num_queries =
+        kernels::CascadeCounters::read(kernels::CASCADE_QUERIES);
+    for (int i = 0; i < NUM_CASCADE_TIERS; i++) {
+        stats.num_resolved[i] = kernels::CascadeCounters::read(i);
+    }
+    stats.num_unresolved =
+        kernels::CascadeCounters::read(kernels::CASCADE_UNRESOLVED);
+    return stats;
+}
+
+/// Reset the statistics of the precision cascade.
+inline void resetPrecisionCascadeStats() { kernels::CascadeCounters::reset(); }
+
+} // namespace ccd
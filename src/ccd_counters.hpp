@@ -0,0 +1,119 @@
+/// @brief Event counters incremented from the CCD queries of many threads
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace ccd {
+namespace kernels {
+
+    /**
+     * @brief Event counters that are cheap to increment from many threads.
+     *
+     * Each thread increments its own copy of the counters, so counting does
+     * not contend between threads. Reading sums the copies of all threads,
+     * including the threads that have exited.
+     *
+     * @tparam Tag  Type distinguishing the sets of counters.
+     * @tparam N    Number of counters in the set.
+     */
+    template <typename Tag, size_t N> class Counters {
+    public:
+        /// Add one to the i-th counter of the calling thread.
+        static void increment(const size_t i) { add(i, 1); }
+
+        /// Add n to the i-th counter of the calling thread.
+        static void add(const size_t i, const uint64_t n)
+        {
+            std::atomic<uint64_t>& value = local().values[i];
+            // Only this thread writes the value, so it does not need a
+            // read-modify-write.
+            value.store(
+                value.load(std::memory_order_relaxed) + n,
+                std::memory_order_relaxed);
+        }
+
+        /// Sum of the i-th counter over all threads.
+        static uint64_t read(const size_t i)
+        {
+            Shared& s = shared();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            uint64_t sum = s.retired[i];
+            for (const Local* l : s.threads) {
+                sum += l->values[i].load(std::memory_order_relaxed);
+            }
+            return sum;
+        }
+
+        /// Set all counters to zero. Increments made concurrently may be lost.
+        static void reset()
+        {
+            Shared& s = shared();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            for (size_t i = 0; i < N; i++) {
+                s.retired[i] = 0;
+                for (Local* l : s.threads) {
+                    l->values[i].store(0, std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        struct Local;
+
+        struct Shared {
+            std::mutex mutex;
+            std::vector<Local*> threads;
+            uint64_t retired[N] = {}; // Counts of the threads that exited
+        };
+
+        struct Local {
+            std::atomic<uint64_t> values[N];
+
+            Local()
+            {
+                for (size_t i = 0; i < N; i++) {
+                    values[i].store(0, std::memory_order_relaxed);
+                }
+                Shared& s = shared();
+                std::lock_guard<std::mutex> lock(s.mutex);
+                s.threads.push_back(this);
+            }
+
+            ~Local()
+            {
+                Shared& s = shared();
+                std::lock_guard<std::mutex> lock(s.mutex);
+                for (size_t i = 0; i < N; i++) {
+                    s.retired[i] += values[i].load(std::memory_order_relaxed);
+                }
+                for (size_t i = 0; i < s.threads.size(); i++) {
+                    if (s.threads[i] == this) {
+                        s.threads[i] = s.threads.back();
+                        s.threads.pop_back();
+                        break;
+                    }
+                }
+            }
+        };
+
+        // Never destroyed, because threads may exit during static destruction.
+        static Shared& shared()
+        {
+            static Shared* s = new Shared;
+            return *s;
+        }
+
+        static Local& local()
+        {
+            thread_local Local l;
+            return l;
+        }
+    };
+
+} // namespace kernels
+} // namespace ccd
@@ -0,0 +1,284 @@
+// Swept bounding box culling of batches of CCD queries
+#include "ccd_culling.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include "ccd_counters.hpp"
+
+// The SIMD kernels are compiled for their instruction sets with target
+// attributes and only called if the CPU supports them.
+#if (defined(__GNUC__) || defined(__clang__))                                  \
+    && (defined(__x86_64__) || defined(_M_X64))
+#include <immintrin.h>
+#define CCD_WRAPPER_CULLING_WITH_X86 1
+#else
+#define CCD_WRAPPER_CULLING_WITH_X86 0
+#endif
+
+namespace ccd {
+
+namespace {
+
+    struct CullingTag;
+    using CullingCounters = kernels::Counters<CullingTag, 2>;
+
+    // Largest difference between the boxes that cannot be a separation. The
+    // computed difference of two coordinates is within one rounding of the
+    // exact one, so the threshold is enlarged by a few ulp.
+    double cull_threshold(const double min_distance)
+    {
+        return std::max(min_distance, 0.0)
+            * (1 + 2 * std::numeric_limits<double>::epsilon());
+    }
+
+    // Whether point j (in [0, 8)) belongs to the first primitive.
+    bool is_first_primitive(const int j, const int num_first_points)
+    {
+        return j % 4 < num_first_points;
+    }
+
+    size_t cull_scalar(
+        const double* coordinates,
+        const size_t stride,
+        const size_t begin,
+        const size_t end,
+        const int num_first_points,
+        const double threshold,
+        size_t* survivors)
+    {
+        size_t num_survivors = 0;
+        for (size_t i = begin; i < end; i++) {
+            bool separated = false, has_nan = false;
+            for (int k = 0; k < 3; k++) {
+                double a_min = std::numeric_limits<double>::infinity();
+                double b_min = a_min, a_max = -a_min, b_max = -a_min;
+                for (int j = 0; j < 8; j++) {
+                    const double x = coordinates[(3 * j + k) * stride + i];
+                    has_nan = has_nan || x != x;
+                    if (is_first_primitive(j, num_first_points)) {
+                        a_min = std::min(a_min, x);
+                        a_max = std::max(a_max, x);
+                    } else {
+                        b_min = std::min(b_min, x);
+                        b_max = std::max(b_max, x);
+                    }
+                }
+                separated = separated || a_min - b_max > threshold
+                    || b_min - a_max > threshold;
+            }
+            survivors[num_survivors] = i;
+            num_survivors += !separated || has_nan;
+        }
+        return num_survivors;
+    }
+
+#if CCD_WRAPPER_CULLING_WITH_X86
+    __attribute__((target("avx2"))) size_t cull_avx2(
+        const double* coordinates,
+        const size_t stride,
+        const size_t num_queries,
+        const int num_first_points,
+        const double threshold,
+        size_t* survivors)
+    {
+        const __m256d t = _mm256_set1_pd(threshold);
+        size_t num_survivors = 0, i = 0;
+        for (; i + 4 <= num_queries; i += 4) {
+            __m256d separated = _mm256_setzero_pd();
+            __m256d has_nan = _mm256_setzero_pd();
+            for (int k = 0; k < 3; k++) {
+                __m256d a_min = _mm256_set1_pd(
+                    std::numeric_limits<double>::infinity());
+                __m256d b_min = a_min;
+                __m256d a_max = _mm256_set1_pd(
+                    -std::numeric_limits<double>::infinity());
+                __m256d b_max = a_max;
+                for (int j = 0; j < 8; j++) {
+                    const __m256d x =
+                        _mm256_loadu_pd(coordinates + (3 * j + k) * stride + i);
+                    has_nan = _mm256_or_pd(
+                        has_nan, _mm256_cmp_pd(x, x, _CMP_UNORD_Q));
+                    if (is_first_primitive(j, num_first_points)) {
+                        a_min = _mm256_min_pd(a_min, x);
+                        a_max = _mm256_max_pd(a_max, x);
+                    } else {
+                        b_min = _mm256_min_pd(b_min, x);
+                        b_max = _mm256_max_pd(b_max, x);
+                    }
+                }
+                separated = _mm256_or_pd(
+                    separated,
+                    _mm256_cmp_pd(_mm256_sub_pd(a_min, b_max), t, _CMP_GT_OQ));
+                separated = _mm256_or_pd(
+                    separated,
+                    _mm256_cmp_pd(_mm256_sub_pd(b_min, a_max), t, _CMP_GT_OQ));
+            }
+            const int culled =
+                _mm256_movemask_pd(_mm256_andnot_pd(has_nan, separated));
+            for (int l = 0; l < 4; l++) {
+                survivors[num_survivors] = i + l;
+                num_survivors += ((culled >> l) & 1) == 0;
+            }
+        }
+        return num_survivors
+            + cull_scalar(
+                   coordinates, stride, i, num_queries, num_first_points,
+                   threshold, survivors + num_survivors);
+    }
+
+// The AVX-512 min and max of GCC 12 trigger a false -Wmaybe-uninitialized
+// (GCC bug 105593).
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+    __attribute__((target("avx512f"))) size_t cull_avx512(
+        const double* coordinates,
+        const size_t stride,
+        const size_t num_queries,
+        const int num_first_points,
+        const double threshold,
+        size_t* survivors)
+    {
+        static_assert(sizeof(size_t) == 8, "Indices are stored as 64 bits");
+        const __m512d t = _mm512_set1_pd(threshold);
+        const __m512i lanes = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+        size_t num_survivors = 0, i = 0;
+        for (; i + 8 <= num_queries; i += 8) {
+            __mmask8 separated = 0, has_nan = 0;
+            for (int k = 0; k < 3; k++) {
+                __m512d a_min =
+                    _mm512_set1_pd(std::numeric_limits<double>::infinity());
+                __m512d b_min = a_min;
+                __m512d a_max =
+                    _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+                __m512d b_max = a_max;
+                for (int j = 0; j < 8; j++) {
+                    const __m512d x =
+                        _mm512_loadu_pd(coordinates + (3 * j + k) * stride + i);
+                    has_nan |= _mm512_cmp_pd_mask(x, x, _CMP_UNORD_Q);
+                    if (is_first_primitive(j, num_first_points)) {
+                        a_min = _mm512_min_pd(a_min, x);
+                        a_max = _mm512_max_pd(a_max, x);
+                    } else {
+                        b_min = _mm512_min_pd(b_min, x);
+                        b_max = _mm512_max_pd(b_max, x);
+                    }
+                }
+                separated |= _mm512_cmp_pd_mask(
+                    _mm512_sub_pd(a_min, b_max), t, _CMP_GT_OQ);
+                separated |= _mm512_cmp_pd_mask(
+                    _mm512_sub_pd(b_min, a_max), t, _CMP_GT_OQ);
+            }
+            const __mmask8 kept = ~separated | has_nan;
+            _mm512_mask_compressstoreu_epi64(
+                survivors + num_survivors, kept,
+                _mm512_add_epi64(_mm512_set1_epi64(i), lanes));
+            num_survivors += __builtin_popcount(kept);
+        }
+        return num_survivors
+            + cull_scalar(
+                   coordinates, stride, i, num_queries, num_first_points,
+                   threshold, survivors + num_survivors);
+    }
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+    SIMDLevel detect_simd_level()
+    {
+#if CCD_WRAPPER_CULLING_WITH_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f")) {
+            return SIMDLevel::AVX512;
+        }
+        if (__builtin_cpu_supports("avx2")) {
+            return SIMDLevel::AVX2;
+        }
+#endif
+        return SIMDLevel::SCALAR;
+    }
+
+} // namespace
+
+SIMDLevel detectedSIMDLevel()
+{
+    static const SIMDLevel level = detect_simd_level();
+    return level;
+}
+
+size_t cullVertexFaceQueries(
+    const double* coordinates,
+    const size_t stride,
+    const size_t num_queries,
+    const double min_distance,
+    size_t* survivors)
+{
+    return kernels::cull_swept_boxes(
+        coordinates, stride, num_queries, /*num_first_points=*/1, min_distance,
+        survivors, detectedSIMDLevel());
+}
+
+size_t cullEdgeEdgeQueries(
+    const double* coordinates,
+    const size_t stride,
+    const size_t num_queries,
+    const double min_distance,
+    size_t* survivors)
+{
+    return kernels::cull_swept_boxes(
+        coordinates, stride, num_queries, /*num_first_points=*/2, min_distance,
+        survivors, detectedSIMDLevel());
+}
+
+FilterStats sweptBoxCullingStats()
+{
+    FilterStats stats;
+    stats.num_queries = CullingCounters::read(0);
+    stats.num_rejected = CullingCounters::read(1);
+    return stats;
+}
+
+void resetSweptBoxCullingStats() { CullingCounters::reset(); }
+
+namespace kernels {
+
+    size_t cull_swept_boxes(
+        const double* coordinates,
+        const size_t stride,
+        const size_t num_queries,
+        const int num_first_points,
+        const double min_distance,
+        size_t* survivors,
+        const SIMDLevel level)
+    {
+        const double threshold = cull_threshold(min_distance);
+        switch (level) {
+#if CCD_WRAPPER_CULLING_WITH_X86
+        case SIMDLevel::AVX512:
+            return cull_avx512(
+                coordinates, stride, num_queries, num_first_points, threshold,
+                survivors);
+        case SIMDLevel::AVX2:
+            return cull_avx2(
+                coordinates, stride, num_queries, num_first_points, threshold,
+                survivors);
+#endif
+        default:
+            return cull_scalar(
+                coordinates, stride, 0, num_queries, num_first_points,
+                threshold, survivors);
+        }
+    }
+
+    void count_culled(const size_t num_queries, const size_t num_culled)
+    {
+        CullingCounters::add(0, num_queries);
+        CullingCounters::add(1, num_culled);
+    }
+
+} // namespace kernels
+
+} // namespace ccd
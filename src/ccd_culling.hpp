@@ -0,0 +1,99 @@
+/// @brief Swept bounding box culling of batches of CCD queries
+
+#pragma once
+
+#include <cstddef>
+
+#include <ccd_filters.hpp>
+
+namespace ccd {
+
+/// Instruction sets of the culling kernel.
+enum class SIMDLevel {
+    SCALAR, ///< Portable scalar code
+    AVX2,   ///< Four queries at a time
+    AVX512  ///< Eight queries at a time with compressed stores
+};
+
+/// Best instruction set of the culling kernel supported by the CPU running
+/// the program. Detected once on the first call.
+SIMDLevel detectedSIMDLevel();
+
+/**
+ * @brief Find the vertex-face queries whose swept bounding boxes overlap.
+ *
+ * The points move linearly, so the swept bounding box of the vertex (resp.
+ * face) is the bounding box of its start and end points. A query whose boxes
+ * are more than min_distance apart on some axis cannot collide and is culled.
+ * The test accounts for rounding and never culls a query that can collide,
+ * including queries with NaN coordinates.
+ *
+ * The queries are in SoA form: coordinate k of point j of query i is
+ * coordinates[(3 * j + k) * stride + i], with the points in the order of the
+ * arguments of vertexFaceCCD.
+ *
+ * @param[in]  coordinates   Coordinates of the queries.
+ * @param[in]  stride        Distance between the coordinate arrays, at least
+ *                           num_queries.
+ * @param[in]  num_queries   Number of queries.
+ * @param[in]  min_distance  Distance by which the boxes are inflated.
+ * @param[out] survivors     Array of num_queries indices. The indices of the
+ *                           queries that were not culled are written in
+ *                           increasing order to its front.
+ *
+ * @returns Number of queries that were not culled.
+ */
+size_t cullVertexFaceQueries(
+    const double* coordinates,
+    const size_t stride,
+    const size_t num_queries,
+    const double min_distance,
+    size_t* survivors);
+
+/**
+ * @brief Find the edge-edge queries whose swept bounding boxes overlap.
+ *
+ * Same as cullVertexFaceQueries, with the points in the order of the
+ * arguments of edgeEdgeCCD.
+ */
+size_t cullEdgeEdgeQueries(
+    const double* coordinates,
+    const size_t stride,
+    const size_t num_queries,
+    const double min_distance,
+    size_t* survivors);
+
+/// Queries tested and culled by the batched and mesh functions, which cull
+/// their queries before running the method. Summed over all threads since the
+/// last reset.
+FilterStats sweptBoxCullingStats();
+
+/// Reset the statistics of the swept bounding box culling.
+void resetSweptBoxCullingStats();
+
+namespace kernels {
+
+    /**
+     * @brief Cull queries with a given instruction set.
+     *
+     * @param num_first_points  Number of points of the first primitive: 1 for
+     *                          vertex-face and 2 for edge-edge queries.
+     * @param level             Instruction set, at most detectedSIMDLevel().
+     *
+     * See cullVertexFaceQueries for the other parameters.
+     */
+    size_t cull_swept_boxes(
+        const double* coordinates,
+        const size_t stride,
+        const size_t num_queries,
+        const int num_first_points,
+        const double min_distance,
+        size_t* survivors,
+        const SIMDLevel level);
+
+    /// Count the queries tested and culled by a batch.
+    void count_culled(const size_t num_queries, const size_t num_culled);
+
+} // namespace kernels
+
+} // namespace ccd
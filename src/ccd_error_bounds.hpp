@@ -0,0 +1,118 @@
+/// @brief Floating-point error bounds of Tight Inclusion shared by a scene
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#include <Eigen/Core>
+
+namespace ccd {
+
+/**
+ * @brief Floating-point error bounds of the vertex-face and edge-edge queries
+ *        of a scene.
+ *
+ * Pass them as the err argument of the CCD functions instead of the default
+ * { -1, 0, 0 }, which makes Tight Inclusion compute a bound for every query
+ * from the coordinates of its points.
+ */
+struct ErrorBounds {
+    /// Error bound of the vertex-face queries
+    Eigen::Array3d vertex_face;
+    /// Error bound of the edge-edge queries
+    Eigen::Array3d edge_edge;
+};
+
+/**
+ * @brief Compute the error bounds of every query inside a bounding box.
+ *
+ * Same bounds as the ones Tight Inclusion computes for a single query, but
+ * using the largest absolute coordinates of the box instead of the ones of
+ * the query. They are therefore valid, if less tight, for all the queries
+ * whose points are inside the box. The filters depend on the precision
+ * Tight Inclusion is built with.
+ *
+ * @param[in] box_min             Minimum corner of the box.
+ * @param[in] box_max             Maximum corner of the box.
+ * @param[in] minimum_separation  Whether the queries use a positive minimum
+ *                                separation distance.
+ *
+ * @returns Error bounds of the queries inside the box.
+ */
+inline ErrorBounds boxErrorBounds(
+    const Eigen::Array3d& box_min,
+    const Eigen::Array3d& box_max,
+    const bool minimum_separation = false)
+{
+#ifdef TIGHT_INCLUSION_WITH_DOUBLE_PRECISION
+    const double vf_filter =
+        minimum_separation ? 7.549516567451064e-15 : 6.661338147750939e-15;
+    const double ee_filter =
+        minimum_separation ? 7.105427357601002e-15 : 6.217248937900877e-15;
+#else
+    const double vf_filter = minimum_separation ? 4.053116e-06 : 3.576279e-06;
+    const double ee_filter = minimum_separation ? 3.814698e-06 : 3.337861e-06;
+#endif
+    const Eigen::Array3d delta =
+        box_min.abs().max(box_max.abs()).min(1.0).cube();
+    return { vf_filter * delta, ee_filter * delta };
+}
+
+/**
+ * @brief Compute the error bounds of the queries between primitives of a
+ *        moving mesh.
+ *
+ * @param[in] V0                  #V × 3 vertex positions at the start.
+ * @param[in] V1                  #V × 3 vertex positions at the end.
+ * @param[in] minimum_separation  Whether the queries use a positive minimum
+ *                                separation distance.
+ *
+ * @returns Error bounds of the queries of the mesh.
+ */
+inline ErrorBounds meshErrorBounds(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const bool minimum_separation = false)
+{
+    if (V0.rows() == 0) {
+        return boxErrorBounds(
+            Eigen::Array3d::Zero(), Eigen::Array3d::Zero(),
+            minimum_separation);
+    }
+    const Eigen::Array3d box_min =
+        V0.colwise().minCoeff().cwiseMin(V1.colwise().minCoeff()).transpose();
+    const Eigen::Array3d box_max =
+        V0.colwise().maxCoeff().cwiseMax(V1.colwise().maxCoeff()).transpose();
+    return boxErrorBounds(box_min, box_max, minimum_separation);
+}
+
+/**
+ * @brief Compute the error bounds of a batch of packed queries.
+ *
+ * @param[in] queries             Packed queries (see vertexFaceCCDBatch).
+ * @param[in] num_queries         Number of queries.
+ * @param[in] minimum_separation  Whether the queries use a positive minimum
+ *                                separation distance.
+ *
+ * @returns Error bounds of the queries of the batch.
+ */
+inline ErrorBounds batchErrorBounds(
+    const double* queries,
+    const size_t num_queries,
+    const bool minimum_separation = false)
+{
+    Eigen::Array3d box_min = Eigen::Array3d::Zero();
+    Eigen::Array3d box_max = Eigen::Array3d::Zero();
+    // 8 points of 3 coordinates per query
+    for (size_t i = 0; i < 8 * num_queries; i++) {
+        for (int k = 0; k < 3; k++) {
+            box_min[k] = std::min(box_min[k], queries[3 * i + k]);
+            box_max[k] = std::max(box_max[k], queries[3 * i + k]);
+        }
+    }
+    return boxErrorBounds(box_min, box_max, minimum_separation);
+}
+
+} // namespace ccd
@@ -0,0 +1,186 @@
+// Work-stealing parallel executor for batches of CCD queries
+#include "ccd_executor.hpp"
+
+#include "ccd_workspace.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ccd {
+
+namespace {
+
+    // Largest chunk a thread takes from its own range. Small enough that an
+    // expensive query does not hold back many cheap ones behind it.
+    const size_t MAX_CHUNK_SIZE = 32;
+
+    // Remaining range of a thread. Padded so that neighbouring ranges do not
+    // share a cache line.
+    struct WorkRange {
+        std::mutex mutex;
+        size_t begin = 0;
+        size_t end = 0;
+        char padding[64];
+    };
+
+} // namespace
+
+struct Executor::Impl {
+    std::vector<std::thread> threads;
+    std::unique_ptr<WorkRange[]> ranges;
+    // Bound to the thread of the same index while it runs a loop.
+    std::unique_ptr<Workspace[]> workspaces;
+    unsigned num_threads;
+
+    // Current loop, guarded by mutex.
+    std::mutex mutex;
+    std::condition_variable start_loop;
+    std::condition_variable end_loop;
+    const std::function<void(size_t, size_t)>* body = nullptr;
+    size_t loop_id = 0;
+    unsigned num_busy = 0;
+    bool stop = false;
+
+    // Take a chunk from the front of the thread's own range.
+    bool pop(const unsigned id, size_t& begin, size_t& end)
+    {
+        WorkRange& range = ranges[id];
+        std::lock_guard<std::mutex> lock(range.mutex);
+        const size_t size = range.end - range.begin;
+        if (size == 0) {
+            return false;
+        }
+        const size_t chunk =
+            std::max<size_t>(1, std::min(size / 8, MAX_CHUNK_SIZE));
+        begin = range.begin;
+        end = range.begin += chunk;
+        return true;
+    }
+
+    // Move the back half of another thread's range into the thread's own.
+    bool steal(const unsigned id)
+    {
+        for (unsigned i = 1; i < num_threads; i++) {
+            WorkRange& victim = ranges[(id + i) % num_threads];
+            size_t begin, end;
+            {
+                std::lock_guard<std::mutex> lock(victim.mutex);
+                const size_t size = victim.end - victim.begin;
+                if (size == 0) {
+                    continue;
+                }
+                begin = victim.begin + size / 2;
+                end = victim.end;
+                victim.end = begin;
+            }
+            std::lock_guard<std::mutex> lock(ranges[id].mutex);
+            ranges[id].begin = begin;
+            ranges[id].end = end;
+            return true;
+        }
+        return false;
+    }
+
+    void work(const unsigned id)
+    {
+        size_t begin, end;
+        do {
+            while (pop(id, begin, end)) {
+                (*body)(begin, end);
+            }
+        } while (steal(id));
+    }
+
+    void worker(const unsigned id)
+    {
+        Workspace::Scope scope(workspaces[id]);
+        size_t last_loop_id = 0;
+        while (true) {
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                start_loop.wait(
+                    lock, [&] { return stop || loop_id != last_loop_id; });
+                if (stop) {
+                    return;
+                }
+                last_loop_id = loop_id;
+            }
+
+            work(id);
+
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--num_busy == 0) {
+                end_loop.notify_one();
+            }
+        }
+    }
+};
+
+Executor::Executor(unsigned num_threads)
+    : impl(new Impl)
+{
+    if (num_threads == 0) {
+        num_threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+    impl->num_threads = num_threads;
+    impl->ranges.reset(new WorkRange[num_threads]);
+    impl->workspaces.reset(new Workspace[num_threads]);
+    impl->threads.reserve(num_threads - 1);
+    for (unsigned id = 1; id < num_threads; id++) {
+        impl->threads.emplace_back(&Impl::worker, impl.get(), id);
+    }
+}
+
+Executor::~Executor()
+{
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->stop = true;
+    }
+    impl->start_loop.notify_all();
+    for (std::thread& thread : impl->threads) {
+        thread.join();
+    }
+}
+
+unsigned Executor::num_threads() const { return impl->num_threads; }
+
+void Executor::run(
+    const size_t n, const std::function<void(size_t, size_t)>& body)
+{
+    if (n == 0) {
+        return;
+    }
+    Workspace::Scope scope(impl->workspaces[0]);
+    const unsigned num_threads = impl->num_threads;
+    if (num_threads == 1 || n == 1) {
+        body(0, n);
+        return;
+    }
+
+    // Start each thread with a contiguous share of the loop.
+    for (unsigned id = 0; id < num_threads; id++) {
+        std::lock_guard<std::mutex> lock(impl->ranges[id].mutex);
+        impl->ranges[id].begin = n * id / num_threads;
+        impl->ranges[id].end = n * (id + 1) / num_threads;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(impl->mutex);
+        impl->body = &body;
+        impl->num_busy = num_threads - 1;
+        impl->loop_id++;
+    }
+    impl->start_loop.notify_all();
+
+    impl->work(0);
+
+    std::unique_lock<std::mutex> lock(impl->mutex);
+    impl->end_loop.wait(lock, [&] { return impl->num_busy == 0; });
+    impl->body = nullptr;
+}
+
+} // namespace ccd
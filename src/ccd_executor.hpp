@@ -0,0 +1,65 @@
+/// @brief Work-stealing parallel executor for batches of CCD queries
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+
+namespace ccd {
+
+/**
+ * @brief Persistent pool of threads running loops with work stealing.
+ *
+ * CCD query costs are heavy-tailed, so a static split of a batch leaves most
+ * threads idle while a few finish their expensive queries. Instead, each
+ * thread starts with a contiguous share of the loop and takes small chunks
+ * from its front. A thread that runs out of work steals the back half of the
+ * remaining range of another thread.
+ *
+ * The calling thread takes part in every loop. Each thread runs the loop with
+ * its own Workspace bound (see setWorkspaceGMPAllocation). An executor must
+ * not be used by more than one thread at a time.
+ */
+class Executor {
+public:
+    /**
+     * @brief Start the worker threads.
+     *
+     * @param[in] num_threads  Total number of threads including the calling
+     *                         thread. Zero uses the number of hardware
+     *                         threads.
+     */
+    explicit Executor(unsigned num_threads = 0);
+    ~Executor();
+
+    Executor(const Executor&) = delete;
+    Executor& operator=(const Executor&) = delete;
+
+    /// Total number of threads including the calling thread.
+    unsigned num_threads() const;
+
+    /**
+     * @brief Run body over the range [0, n) in parallel.
+     *
+     * Returns once every index has been processed. Chunks are disjoint and
+     * cover [0, n) exactly once, so body can write its results by index to
+     * keep them in input order.
+     *
+     * @param[in] n     Number of iterations.
+     * @param[in] body  Callable body(begin, end) processing [begin, end). It
+     *                  must not throw.
+     */
+    template <typename Body> void parallel_for(const size_t n, Body&& body)
+    {
+        run(n, std::function<void(size_t, size_t)>(std::ref(body)));
+    }
+
+private:
+    void run(const size_t n, const std::function<void(size_t, size_t)>& body);
+
+    struct Impl;
+    std::unique_ptr<Impl> impl;
+};
+
+} // namespace ccd
@@ -0,0 +1,584 @@
+/// @brief Conservative filters run before the CCD methods
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+
+#include <Eigen/Geometry>
+
+#include <ccd_counters.hpp>
+#include <ccd_method.hpp>
+
+namespace ccd {
+
+/// Number of queries the zero-motion fast path detected and answered.
+struct ZeroMotionStats {
+    uint64_t num_queries = 0;     ///< Queries tested for zero motion.
+    uint64_t num_static = 0;      ///< Queries whose points do not move.
+    uint64_t num_translating = 0; ///< Queries translated as a whole.
+    /// Static or translating queries answered without running the method.
+    uint64_t num_answered = 0;
+};
+
+/// Number of queries a filter tested and rejected for one method.
+struct FilterStats {
+    uint64_t num_queries = 0;  ///< Queries tested by the filter.
+    uint64_t num_rejected = 0; ///< Queries proven collision free.
+
+    /// Fraction of the tested queries that were rejected.
+    double rejection_rate() const
+    {
+        return num_queries > 0 ? double(num_rejected) / double(num_queries)
+                               : 0.0;
+    }
+};
+
+namespace kernels {
+
+    struct NonPenetrationFilterTag;
+    using NonPenetrationFilterCounters =
+        Counters<NonPenetrationFilterTag, 2 * NUM_CCD_METHODS>;
+
+    inline std::atomic<bool>* non_penetration_filter_flags()
+    {
+        static std::atomic<bool> flags[NUM_CCD_METHODS] = {};
+        return flags;
+    }
+
+    /// Bernstein coefficient of det(u, v, w) and the permanent of its terms.
+    struct Coefficient {
+        double value = 0;
+        double permanent = 0;
+
+        void add(
+            const Eigen::Vector3d& u,
+            const Eigen::Vector3d& v,
+            const Eigen::Vector3d& w)
+        {
+            value += u.dot(v.cross(w));
+            const Eigen::Vector3d a = u.cwiseAbs(), b = v.cwiseAbs(),
+                                  c = w.cwiseAbs();
+            permanent += a.x() * (b.y() * c.z() + b.z() * c.y())
+                + a.y() * (b.z() * c.x() + b.x() * c.z())
+                + a.z() * (b.x() * c.y() + b.y() * c.x());
+        }
+    };
+
+    /**
+     * @brief Prove that four linearly moving points are never coplanar in
+     *        [0, 1].
+     *
+     * The points are coplanar when f(t) = det(x1 - x0, x2 - x0, x3 - x0) is
+     * zero. Each difference is linear in t, so f is a cubic whose Bernstein
+     * coefficients are sums of determinants of the differences at t = 0 and
+     * t = 1 [Tang et al. 2010]. By the convex hull property, f has no root in
+     * [0, 1] if all coefficients have the same strict sign.
+     *
+     * A coefficient is only trusted if it exceeds a bound on its rounding
+     * error, so the test never rejects a coplanar configuration.
+     *
+     * @returns True if the points are never coplanar.
+     */
+    inline bool is_never_coplanar(
+        const Eigen::Vector3d& x0_start,
+        const Eigen::Vector3d& x1_start,
+        const Eigen::Vector3d& x2_start,
+        const Eigen::Vector3d& x3_start,
+        const Eigen::Vector3d& x0_end,
+        const Eigen::Vector3d& x1_end,
+        const Eigen::Vector3d& x2_end,
+        const Eigen::Vector3d& x3_end)
+    {
+        const Eigen::Vector3d u0 = x1_start - x0_start;
+        const Eigen::Vector3d v0 = x2_start - x0_start;
+        const Eigen::Vector3d w0 = x3_start - x0_start;
+        const Eigen::Vector3d u1 = x1_end - x0_end;
+        const Eigen::Vector3d v1 = x2_end - x0_end;
+        const Eigen::Vector3d w1 = x3_end - x0_end;
+
+        // Coefficients scaled by the binomial coefficients, which does not
+        // change their signs.
+        Coefficient b[4];
+        b[0].add(u0, v0, w0);
+        b[1].add(u1, v0, w0);
+        b[1].add(u0, v1, w0);
+        b[1].add(u0, v0, w1);
+        b[2].add(u1, v1, w0);
+        b[2].add(u1, v0, w1);
+        b[2].add(u0, v1, w1);
+        b[3].add(u1, v1, w1);
+
+        // The error of a determinant of differences is below 7u times its
+        // permanent, where u is the unit roundoff [Shewchuk 1997], and summing
+        // three of them adds 2u. The bound leaves room for the rounding of the
+        // permanents, and the absolute term covers underflow.
+        const double relative_error =
+            16 * std::numeric_limits<double>::epsilon();
+        const double absolute_error = std::numeric_limits<double>::min();
+
+        bool all_positive = true, all_negative = true;
+        for (const Coefficient& c : b) {
+            const double error = relative_error * c.permanent + absolute_error;
+            all_positive = all_positive && c.value > error;
+            all_negative = all_negative && c.value < -error;
+        }
+        return all_positive || all_negative;
+    }
+
+    /// Run the non-penetration filter if it is enabled for the method.
+    inline bool non_penetration_filter_rejects(
+        const CCDMethod method,
+        const Eigen::Vector3d& x0_start,
+        const Eigen::Vector3d& x1_start,
+        const Eigen::Vector3d& x2_start,
+        const Eigen::Vector3d& x3_start,
+        const Eigen::Vector3d& x0_end,
+        const Eigen::Vector3d& x1_end,
+        const Eigen::Vector3d& x2_end,
+        const Eigen::Vector3d& x3_end)
+    {
+        if (!non_penetration_filter_flags()[method].load(
+                std::memory_order_relaxed)) {
+            return false;
+        }
+        NonPenetrationFilterCounters::increment(2 * method);
+        const bool rejected = is_never_coplanar(
+            x0_start, x1_start, x2_start, x3_start, x0_end, x1_end, x2_end,
+            x3_end);
+        if (rejected) {
+            NonPenetrationFilterCounters::increment(2 * method + 1);
+        }
+        return rejected;
+    }
+
+    struct RootParityFilterTag;
+    using RootParityFilterCounters =
+        Counters<RootParityFilterTag, 2 * NUM_CCD_METHODS>;
+
+    inline std::atomic<bool>& root_parity_filter_flag()
+    {
+        static std::atomic<bool> flag(true);
+        return flag;
+    }
+
+    /// Whether a method is one of the root parity methods, which evaluate
+    /// their predicates exactly.
+    constexpr bool is_root_parity_method(const CCDMethod method)
+    {
+        return method == CCDMethod::ROOT_PARITY
+            || method == CCDMethod::RATIONAL_ROOT_PARITY
+            || method == CCDMethod::RATIONAL_FIXED_ROOT_PARITY;
+    }
+
+    /**
+     * @brief Whether the swept bounding boxes of two linearly moving
+     *        primitives are disjoint.
+     *
+     * Only compares coordinates, so the test is exact.
+     *
+     * @param num_first_points  Number of points of the first primitive: 1 for
+     *                          vertex-face and 2 for edge-edge queries.
+     * @param x                 Start then end points of the query.
+     */
+    inline bool are_swept_boxes_disjoint(
+        const int num_first_points, const Eigen::Vector3d* const (&x)[8])
+    {
+        for (int k = 0; k < 3; k++) {
+            double a_min = std::numeric_limits<double>::infinity();
+            double b_min = a_min, a_max = -a_min, b_max = -a_min;
+            for (int j = 0; j < 8; j++) {
+                const double c = (*x[j])[k];
+                if (j % 4 < num_first_points) {
+                    a_min = std::min(a_min, c);
+                    a_max = std::max(a_max, c);
+                } else {
+                    b_min = std::min(b_min, c);
+                    b_max = std::max(b_max, c);
+                }
+            }
+            if (a_min > b_max || b_min > a_max) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /**
+     * @brief Semi-static version of is_never_coplanar.
+     *
+     * Instead of the permanent of each coefficient, the error bound uses the
+     * largest magnitude M of the coordinate differences. A coefficient sums at
+     * most three determinants, whose permanents are at most 6 M^3, so its
+     * error is below 16 * 18 * eps * M^3. The bound is rounded up to 320 to
+     * cover its own rounding.
+     */
+    inline bool is_never_coplanar_semi_static(
+        const Eigen::Vector3d* const (&x)[8])
+    {
+        const Eigen::Vector3d u0 = *x[1] - *x[0], v0 = *x[2] - *x[0],
+                              w0 = *x[3] - *x[0];
+        const Eigen::Vector3d u1 = *x[5] - *x[4], v1 = *x[6] - *x[4],
+                              w1 = *x[7] - *x[4];
+        const double m = std::max(
+            { u0.cwiseAbs().maxCoeff(), v0.cwiseAbs().maxCoeff(),
+              w0.cwiseAbs().maxCoeff(), u1.cwiseAbs().maxCoeff(),
+              v1.cwiseAbs().maxCoeff(), w1.cwiseAbs().maxCoeff() });
+        const double error =
+            320 * std::numeric_limits<double>::epsilon() * (m * m * m)
+            + std::numeric_limits<double>::min();
+
+        const double b[4] = {
+            u0.dot(v0.cross(w0)),
+            u1.dot(v0.cross(w0)) + u0.dot(v1.cross(w0)) + u0.dot(v0.cross(w1)),
+            u1.dot(v1.cross(w0)) + u1.dot(v0.cross(w1)) + u0.dot(v1.cross(w1)),
+            u1.dot(v1.cross(w1)),
+        };
+        bool all_positive = true, all_negative = true;
+        for (const double c : b) {
+            all_positive = all_positive && c > error;
+            all_negative = all_negative && c < -error;
+        }
+        return all_positive || all_negative;
+    }
+
+    /**
+     * @brief Run the floating-point filter of the root parity methods.
+     *
+     * @param num_first_points  Number of points of the first primitive: 1 for
+     *                          vertex-face and 2 for edge-edge queries.
+     * @param x                 Start then end points of the query.
+     *
+     * @returns True if the query is proven collision free.
+     */
+    inline bool root_parity_filter_rejects(
+        const CCDMethod method,
+        const int num_first_points,
+        const Eigen::Vector3d* const (&x)[8])
+    {
+        if (!is_root_parity_method(method)
+            || !root_parity_filter_flag().load(std::memory_order_relaxed)) {
+            return false;
+        }
+        RootParityFilterCounters::increment(2 * method);
+        const bool rejected = are_swept_boxes_disjoint(num_first_points, x)
+            || is_never_coplanar_semi_static(x);
+        if (rejected) {
+            RootParityFilterCounters::increment(2 * method + 1);
+        }
+        return rejected;
+    }
+
+    struct ZeroMotionTag;
+    // Counts of the tested, static, translating, and answered queries.
+    using ZeroMotionCounters = Counters<ZeroMotionTag, 4>;
+
+    inline std::atomic<bool>& zero_motion_flag()
+    {
+        static std::atomic<bool> flag(true);
+        return flag;
+    }
+
+    /// Motion of the points of a query relative to each other.
+    enum class RelativeMotion {
+        GENERAL,    ///< The points move relative to each other.
+        STATIC,     ///< No point moves.
+        TRANSLATION ///< All points move by the same vector.
+    };
+
+    /// Whether a - b is exactly representable, i.e., fl(a - b) == a - b
+    /// (Knuth's TwoSum).
+    inline bool is_exact_difference(const double a, const double b)
+    {
+        const double d = a - b;
+        const double b_virtual = d - a;
+        return (a - (d - b_virtual)) + (-b - b_virtual) == 0;
+    }
+
+    /**
+     * @brief Find whether the points of a query keep their relative
+     *        positions.
+     *
+     * A translation is only detected if the displacements of all points are
+     * exactly equal, so the configuration is exactly the same at all times.
+     *
+     * @param x  Start then end points of the query.
+     */
+    inline RelativeMotion
+    relative_motion(const Eigen::Vector3d* const (&x)[8])
+    {
+        bool is_static = true;
+        for (int i = 0; i < 4; i++) {
+            is_static = is_static && *x[i + 4] == *x[i];
+        }
+        if (is_static) {
+            return RelativeMotion::STATIC;
+        }
+        const Eigen::Vector3d d = *x[4] - *x[0];
+        for (int i = 0; i < 4; i++) {
+            for (int k = 0; k < 3; k++) {
+                const double a = (*x[i + 4])[k], b = (*x[i])[k];
+                if (a - b != d[k] || !is_exact_difference(a, b)) {
+                    return RelativeMotion::GENERAL;
+                }
+            }
+        }
+        return RelativeMotion::TRANSLATION;
+    }
+
+    /**
+     * @brief Prove that two motionless primitives are farther apart than a
+     *        distance.
+     *
+     * The distance between the primitives is at least the gap between their
+     * bounding boxes, and at least the distance from the vertex to the plane
+     * of the face (resp. between the lines of the edges). The minimum
+     * separation of Tight Inclusion is measured in the infinity norm, which
+     * can be smaller than the Euclidean distance by a factor √3, so the
+     * distance to the plane is bounded below in both norms by |det| / |n|₁
+     * with det = det(p1 - p0, p2 - p0, p3 - p0) and n the normal of the face
+     * (resp. the cross product of the edges). Both are compared with error
+     * bounds, so the test never rejects primitives within the distance.
+     *
+     * @param num_first_points  Number of points of the first primitive: 1 for
+     *                          vertex-face and 2 for edge-edge queries.
+     * @param p                 Points of the primitives.
+     * @param min_distance      Distance to exceed, zero for an intersection.
+     *
+     * @returns True if the primitives are farther apart than min_distance.
+     */
+    inline bool are_static_primitives_apart(
+        const int num_first_points,
+        const Eigen::Vector3d* const (&p)[4],
+        const double min_distance)
+    {
+        const double eps = std::numeric_limits<double>::epsilon();
+        const double distance = std::max(min_distance, 0.0);
+
+        const double box_threshold = distance * (1 + 2 * eps);
+        for (int k = 0; k < 3; k++) {
+            double a_min = std::numeric_limits<double>::infinity();
+            double b_min = a_min, a_max = -a_min, b_max = -a_min;
+            for (int j = 0; j < 4; j++) {
+                const double c = (*p[j])[k];
+                if (j < num_first_points) {
+                    a_min = std::min(a_min, c);
+                    a_max = std::max(a_max, c);
+                } else {
+                    b_min = std::min(b_min, c);
+                    b_max = std::max(b_max, c);
+                }
+            }
+            if (a_min - b_max > box_threshold
+                || b_min - a_max > box_threshold) {
+                return true;
+            }
+        }
+
+        Coefficient det;
+        det.add(*p[1] - *p[0], *p[2] - *p[0], *p[3] - *p[0]);
+        const double det_error =
+            8 * eps * det.permanent + std::numeric_limits<double>::min();
+
+        // Normal of the face, or cross product of the edges
+        const Eigen::Vector3d a =
+            num_first_points == 1 ? *p[2] - *p[1] : *p[1] - *p[0];
+        const Eigen::Vector3d b = *p[3] - *p[2];
+        const Eigen::Vector3d n = a.cross(b);
+        const Eigen::Vector3d a_abs = a.cwiseAbs(), b_abs = b.cwiseAbs();
+        const Eigen::Vector3d n_permanent(
+            a_abs.y() * b_abs.z() + a_abs.z() * b_abs.y(),
+            a_abs.z() * b_abs.x() + a_abs.x() * b_abs.z(),
+            a_abs.x() * b_abs.y() + a_abs.y() * b_abs.x());
+        const double n_upper =
+            (n.lpNorm<1>() + 4 * eps * n_permanent.lpNorm<1>()) * (1 + 4 * eps);
+
+        return std::abs(det.value) - det_error
+            > distance * n_upper * (1 + 4 * eps);
+    }
+
+    /**
+     * @brief Answer a query whose points keep their relative positions with
+     *        a static test, if the fast path is enabled.
+     *
+     * Such primitives collide at some time iff they collide at all times, so
+     * the query is collision free if the primitives are apart at the start.
+     *
+     * @param num_first_points  Number of points of the first primitive: 1 for
+     *                          vertex-face and 2 for edge-edge queries.
+     * @param min_distance      Minimum separation distance, zero for CCD.
+     * @param x                 Start then end points of the query.
+     *
+     * @returns True if the query is proven collision free.
+     */
+    inline bool zero_motion_rejects(
+        const int num_first_points,
+        const double min_distance,
+        const Eigen::Vector3d* const (&x)[8])
+    {
+        if (!zero_motion_flag().load(std::memory_order_relaxed)) {
+            return false;
+        }
+        ZeroMotionCounters::increment(0);
+        const RelativeMotion motion = relative_motion(x);
+        if (motion == RelativeMotion::GENERAL) {
+            return false;
+        }
+        ZeroMotionCounters::increment(
+            motion == RelativeMotion::STATIC ? 1 : 2);
+        const bool rejected = are_static_primitives_apart(
+            num_first_points, { x[0], x[1], x[2], x[3] }, min_distance);
+        if (rejected) {
+            ZeroMotionCounters::increment(3);
+        }
+        return rejected;
+    }
+
+} // namespace kernels
+
+/**
+ * @brief Enable or disable the deforming non-penetration filter for a method.
+ *
+ * A vertex and a face, or two edges, can only collide when their four points
+ * are coplanar. The filter proves with a few determinants that they are never
+ * coplanar in [0, 1] and then answers false without calling the method. It
+ * never rejects a colliding query, but it does remove the false positives of
+ * conservative methods on the queries it rejects.
+ *
+ * Coplanarity only implies a collision for a zero minimum separation, so the
+ * filter applies to vertexFaceCCD and edgeEdgeCCD, and to the minimum
+ * separation functions when the minimum separation distance is zero. The
+ * plain functions of MIN_SEPARATION_ROOT_FINDER look for collisions within
+ * DEFAULT_MIN_DISTANCE and are not filtered. It is disabled for every method
+ * by default.
+ *
+ * @param[in] method   Method to filter.
+ * @param[in] enabled  Whether to run the filter before the method.
+ */
+inline void setNonPenetrationFilter(const CCDMethod method, const bool enabled)
+{
+    if (method >= 0 && method < NUM_CCD_METHODS) {
+        kernels::non_penetration_filter_flags()[method].store(enabled);
+    }
+}
+
+/// Whether the deforming non-penetration filter is enabled for a method.
+inline bool isNonPenetrationFilterEnabled(const CCDMethod method)
+{
+    return method >= 0 && method < NUM_CCD_METHODS
+        && kernels::non_penetration_filter_flags()[method].load();
+}
+
+/// Queries tested and rejected by the non-penetration filter for a method,
+/// summed over all threads since the last reset.
+inline FilterStats nonPenetrationFilterStats(const CCDMethod method)
+{
+    FilterStats stats;
+    if (method >= 0 && method < NUM_CCD_METHODS) {
+        stats.num_queries =
+            kernels::NonPenetrationFilterCounters::read(2 * method);
+        stats.num_rejected =
+            kernels::NonPenetrationFilterCounters::read(2 * method + 1);
+    }
+    return stats;
+}
+
+/// Reset the statistics of the non-penetration filter for all methods.
+inline void resetNonPenetrationFilterStats()
+{
+    kernels::NonPenetrationFilterCounters::reset();
+}
+
+/**
+ * @brief Enable or disable the floating-point filter of the root parity
+ *        methods.
+ *
+ * ROOT_PARITY, RATIONAL_ROOT_PARITY and RATIONAL_FIXED_ROOT_PARITY evaluate
+ * their predicates exactly, which is slow when a double evaluation already
+ * decides the query. The filter answers false in double precision when the
+ * swept bounding boxes of the primitives are disjoint, or when a semi-static
+ * error bound proves that their points are never coplanar. Either proves that
+ * the primitives do not collide, so the exact methods return the same answer,
+ * and only the queries the filter cannot decide run the exact predicates.
+ *
+ * The filter is enabled by default.
+ *
+ * @param[in] enabled  Whether to run the filter before the root parity
+ *                     methods.
+ */
+inline void setRootParityFilter(const bool enabled)
+{
+    kernels::root_parity_filter_flag().store(enabled);
+}
+
+/// Whether the floating-point filter of the root parity methods is enabled.
+inline bool isRootParityFilterEnabled()
+{
+    return kernels::root_parity_filter_flag().load();
+}
+
+/// Queries tested and rejected by the floating-point filter of a root parity
+/// method, summed over all threads since the last reset.
+inline FilterStats rootParityFilterStats(const CCDMethod method)
+{
+    FilterStats stats;
+    if (method >= 0 && method < NUM_CCD_METHODS) {
+        stats.num_queries =
+            kernels::RootParityFilterCounters::read(2 * method);
+        stats.num_rejected =
+            kernels::RootParityFilterCounters::read(2 * method + 1);
+    }
+    return stats;
+}
+
+/// Reset the statistics of the floating-point filter of the root parity
+/// methods.
+inline void resetRootParityFilterStats()
+{
+    kernels::RootParityFilterCounters::reset();
+}
+
+/**
+ * @brief Enable or disable the zero-motion fast path.
+ *
+ * When no point of a query moves, or all points move by exactly the same
+ * vector, the relative configuration of the primitives never changes. The
+ * fast path then proves with a static distance test (bounding boxes and
+ * distance to the plane of the face or between the lines of the edges) that
+ * the primitives are farther apart than the minimum separation distance, and
+ * answers false without running the method. Queries it cannot decide, e.g.,
+ * resting contacts, run the method.
+ *
+ * The fast path applies to all methods and is enabled by default.
+ *
+ * @param[in] enabled  Whether to run the fast path before the methods.
+ */
+inline void setZeroMotionFastPath(const bool enabled)
+{
+    kernels::zero_motion_flag().store(enabled);
+}
+
+/// Whether the zero-motion fast path is enabled.
+inline bool isZeroMotionFastPathEnabled()
+{
+    return kernels::zero_motion_flag().load();
+}
+
+/// Queries detected and answered by the zero-motion fast path, summed over all
+/// threads since the last reset.
+inline ZeroMotionStats zeroMotionStats()
+{
+    ZeroMotionStats stats;
+    stats.num_queries = kernels::ZeroMotionCounters::read(0);
+    stats.num_static = kernels::ZeroMotionCounters::read(1);
+    stats.num_translating = kernels::ZeroMotionCounters::read(2);
+    stats.num_answered = kernels::ZeroMotionCounters::read(3);
+    return stats;
+}
+
+/// Reset the statistics of the zero-motion fast path.
+inline void resetZeroMotionStats() { kernels::ZeroMotionCounters::reset(); }
+
+} // namespace ccd
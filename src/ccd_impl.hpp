@@ -0,0 +1,740 @@
+/// @brief Definitions of the functions declared in ccd.hpp
+///
+/// Compiled into the library by ccd.cpp, or included by ccd.hpp in the
+/// header-only build (CCD_WRAPPER_HEADER_ONLY) so the adapters can be inlined
+/// into the caller.
+
+#pragma once
+
+#include <ccd.hpp>
+#include <ccd_kernels.hpp>
+
+namespace ccd {
+
+// Detect collisions between a vertex and a triangular face.
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    CCDResult result;
+    return vertexFaceCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        method, result, tolerance, max_iter, err);
+}
+
+// Same as above, but also compute the time of impact.
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const CCDStatus status = tryVertexFaceCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Vertex-face", method, status);
+    }
+    return result.hit;
+}
+
+// Noexcept version of vertexFaceCCD.
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err) noexcept
+{
+    return kernels::run_query<kernels::VertexFaceCCD>(
+        method, result,
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        tolerance, max_iter, err);
+}
+
+// Detect collisions between two edges as they move.
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    CCDResult result;
+    return edgeEdgeCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        method, result, tolerance, max_iter, err);
+}
+
+// Same as above, but also compute the time of impact.
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const CCDStatus status = tryEdgeEdgeCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Edge-edge", method, status);
+    }
+    return result.hit;
+}
+
+// Noexcept version of edgeEdgeCCD.
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err) noexcept
+{
+    return kernels::run_query<kernels::EdgeEdgeCCD>(
+        method, result,
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        tolerance, max_iter, err);
+}
+
+// Detect proximity collisions between a vertex and a triangular face.
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    CCDResult result;
+    return vertexFaceMSCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, method, result, tolerance, max_iter, err);
+}
+
+// Same as above, but also compute the time of impact.
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const CCDStatus status = tryVertexFaceMSCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Vertex-face", method, status);
+    }
+    return result.hit;
+}
+
+// Noexcept version of vertexFaceMSCCD.
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err) noexcept
+{
+    return kernels::run_query<kernels::VertexFaceMSCCD>(
+        method, result,
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, tolerance, max_iter, err);
+}
+
+// Detect proximity collisions between two edges as they move.
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    CCDResult result;
+    return edgeEdgeMSCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, method, result, tolerance, max_iter, err);
+}
+
+// Same as above, but also compute the time of impact.
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const CCDStatus status = tryEdgeEdgeMSCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Edge-edge", method, status);
+    }
+    return result.hit;
+}
+
+// Noexcept version of edgeEdgeMSCCD.
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err) noexcept
+{
+    return kernels::run_query<kernels::EdgeEdgeMSCCD>(
+        method, result,
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, tolerance, max_iter, err);
+}
+
+} // namespace ccd
+
+namespace ccd {
+
+// Single precision versions
+
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const CCDMethod method,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    CCDResult result;
+    return vertexFaceCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        method, result, tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool vertexFaceCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    const CCDStatus status = tryVertexFaceCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Vertex-face", method, status);
+    }
+    return result.hit;
+}
+
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err) noexcept
+{
+    return kernels::run_float_query<kernels::VertexFaceCCD>(
+        method, result,
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const CCDMethod method,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    CCDResult result;
+    return edgeEdgeCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        method, result, tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool edgeEdgeCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    const CCDStatus status = tryEdgeEdgeCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Edge-edge", method, status);
+    }
+    return result.hit;
+}
+
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err) noexcept
+{
+    return kernels::run_float_query<kernels::EdgeEdgeCCD>(
+        method, result,
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const float min_distance,
+    const CCDMethod method,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    CCDResult result;
+    return vertexFaceMSCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, method, result, tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool vertexFaceMSCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const float min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    const CCDStatus status = tryVertexFaceMSCCD(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Vertex-face", method, status);
+    }
+    return result.hit;
+}
+
+CCD_WRAPPER_INLINE CCDStatus tryVertexFaceMSCCD(
+    const Eigen::Vector3f& vertex_start,
+    const Eigen::Vector3f& face_vertex0_start,
+    const Eigen::Vector3f& face_vertex1_start,
+    const Eigen::Vector3f& face_vertex2_start,
+    const Eigen::Vector3f& vertex_end,
+    const Eigen::Vector3f& face_vertex0_end,
+    const Eigen::Vector3f& face_vertex1_end,
+    const Eigen::Vector3f& face_vertex2_end,
+    const float min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err) noexcept
+{
+    return kernels::run_float_query<kernels::VertexFaceMSCCD>(
+        method, result,
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const float min_distance,
+    const CCDMethod method,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    CCDResult result;
+    return edgeEdgeMSCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, method, result, tolerance, max_iter, err);
+}
+
+CCD_WRAPPER_INLINE bool edgeEdgeMSCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const float min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err)
+{
+    const CCDStatus status = tryEdgeEdgeMSCCD(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, method, result, tolerance, max_iter, err);
+    if (kernels::is_failure(status)) {
+        // Conservative answer upon failure.
+        kernels::report_failure("Edge-edge", method, status);
+    }
+    return result.hit;
+}
+
+CCD_WRAPPER_INLINE CCDStatus tryEdgeEdgeMSCCD(
+    const Eigen::Vector3f& edge0_vertex0_start,
+    const Eigen::Vector3f& edge0_vertex1_start,
+    const Eigen::Vector3f& edge1_vertex0_start,
+    const Eigen::Vector3f& edge1_vertex1_start,
+    const Eigen::Vector3f& edge0_vertex0_end,
+    const Eigen::Vector3f& edge0_vertex1_end,
+    const Eigen::Vector3f& edge1_vertex0_end,
+    const Eigen::Vector3f& edge1_vertex1_end,
+    const float min_distance,
+    const CCDMethod method,
+    CCDResult& result,
+    const float tolerance,
+    const long max_iter,
+    const Eigen::Array3f& err) noexcept
+{
+    return kernels::run_float_query<kernels::EdgeEdgeMSCCD>(
+        method, result,
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, tolerance, max_iter, err);
+}
+
+} // namespace ccd
@@ -0,0 +1,2432 @@
+/// @brief Per-method adapters shared by the scalar and batched CCD functions.
+///
+/// Each CCD method is wrapped in a functor specialised on its CCDMethod, so a
+/// caller that already knows the method (e.g., a batch loop) can call the
+/// adapter directly instead of going through the runtime switch.
+///
+/// Adapters only look for collisions in [0, t_max] when the method supports
+/// it (Tight Inclusion). Other methods ignore t_max and check [0, 1].
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include <ccd.hpp>
+#include <ccd_cascade.hpp>
+#include <ccd_culling.hpp>
+#include <ccd_filters.hpp>
+#include <ccd_normalization.hpp>
+#include <ccd_obstacle.hpp>
+
+// Etienne Vouga's CCD using a root finder in floating points
+#if CCD_WRAPPER_WITH_FPRF
+#include <CTCD.h>
+#endif
+// Root parity method of Brochu et al. [2012]
+#if CCD_WRAPPER_WITH_RP
+#include <rootparitycollisiontest.h>
+#endif
+// Teseo's reimplementation of Brochu et al. [2012] using rationals
+#if CCD_WRAPPER_WITH_RRP
+#include <ECCD.hpp>
+#endif
+// Bernstein sign classification method of Tang et al. [2014]
+#if CCD_WRAPPER_WITH_BSC
+#include <bsc.h>
+#endif
+// TightCCD method of Wang et al. [2015]
+#if CCD_WRAPPER_WITH_TIGHT_CCD
+#include <bsc_tightbound.h>
+#endif
+// SafeCCD
+#if ENABLE_SAFE_CCD
+#include <SAFE_CCD.h>
+#endif
+// Rational root parity with fixes
+#if CCD_WRAPPER_WITH_RFRP
+#include <CCD/ccd.hpp>
+#endif
+// Floating-point root parity with fixes
+#if CCD_WRAPPER_WITH_FPRP
+#include <doubleCCD/doubleccd.hpp>
+#endif
+// Minimum separation root finder of Harmon et al. [2011]
+#if CCD_WRAPPER_WITH_MSRF
+#include <minimum_separation_root_finder.hpp>
+#endif
+// Interval based CCD of [Redon et al. 2002]
+// Interval based CCD of [Redon et al. 2002] solved using [Snyder 1992]
+#if CCD_WRAPPER_WITH_INTERVAL
+#include <interval_ccd/interval_ccd.hpp>
+#endif
+// Custom inclusion based CCD of [Wang et al. 2020]
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION
+#include <tight_inclusion/ccd.hpp>
+#endif
+
+// Exceptions are optional. Without them (e.g., -fno-exceptions), failures of
+// the underlying libraries cannot be caught, but everything else still works.
+#if defined(__cpp_exceptions) || defined(__EXCEPTIONS) || defined(_CPPUNWIND)
+#define CCD_WRAPPER_HAS_EXCEPTIONS 1
+#else
+#define CCD_WRAPPER_HAS_EXCEPTIONS 0
+#endif
+
+namespace ccd {
+namespace kernels {
+
+/// Answer of an adapter for an invalid or disabled method. Callers check the
+/// method with method_status() first, so this is only a conservative fallback.
+inline bool unavailable() { return true; }
+
+/// Vertex-face CCD adapter for a single method.
+template <CCDMethod method> struct VertexFaceCCD {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return unavailable();
+    }
+};
+
+/// Edge-edge CCD adapter for a single method.
+template <CCDMethod method> struct EdgeEdgeCCD {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return unavailable();
+    }
+};
+
+/// Vertex-face minimum separation CCD adapter for a single method.
+template <CCDMethod method> struct VertexFaceMSCCD {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double min_distance,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return unavailable();
+    }
+};
+
+/// Edge-edge minimum separation CCD adapter for a single method.
+template <CCDMethod method> struct EdgeEdgeMSCCD {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double min_distance,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return unavailable();
+    }
+};
+
+/// Whether a kernel template is one of the minimum separation kernels.
+template <template <CCDMethod> class Kernel>
+struct is_minimum_separation_kernel : std::false_type { };
+template <>
+struct is_minimum_separation_kernel<VertexFaceMSCCD> : std::true_type { };
+template <>
+struct is_minimum_separation_kernel<EdgeEdgeMSCCD> : std::true_type { };
+
+/// Minimum separation distance the plain kernels of a method run with:
+/// MIN_SEPARATION_ROOT_FINDER has no zero distance mode and looks for
+/// collisions within DEFAULT_MIN_DISTANCE.
+constexpr double plain_min_distance(const CCDMethod method)
+{
+    return method == CCDMethod::MIN_SEPARATION_ROOT_FINDER
+        ? DEFAULT_MIN_DISTANCE
+        : 0;
+}
+
+/**
+ * @brief Call a visitor with the kernel specialised for a runtime method.
+ *
+ * This is the only place the runtime method is switched on. Batched callers
+ * put their loop inside the visitor, so the switch is evaluated once per batch
+ * and the kernel call inside the loop is resolved at compile time.
+ *
+ * @tparam Kernel   One of the kernel templates above.
+ * @param  method   Method to dispatch on.
+ * @param  visitor  Callable invoked with a default constructed Kernel<method>.
+ *
+ * @returns The value returned by the visitor.
+ */
+template <template <CCDMethod> class Kernel, typename Visitor>
+auto dispatch(const CCDMethod method, Visitor&& visitor)
+    -> decltype(visitor(Kernel<CCDMethod::FLOATING_POINT_ROOT_FINDER>()))
+{
+    switch (method) {
+    case CCDMethod::FLOATING_POINT_ROOT_FINDER:
+        return visitor(Kernel<CCDMethod::FLOATING_POINT_ROOT_FINDER>());
+    case CCDMethod::MIN_SEPARATION_ROOT_FINDER:
+        return visitor(Kernel<CCDMethod::MIN_SEPARATION_ROOT_FINDER>());
+    case CCDMethod::ROOT_PARITY:
+        return visitor(Kernel<CCDMethod::ROOT_PARITY>());
+    case CCDMethod::RATIONAL_ROOT_PARITY:
+        return visitor(Kernel<CCDMethod::RATIONAL_ROOT_PARITY>());
+    case CCDMethod::FLOATING_POINT_ROOT_PARITY:
+        return visitor(Kernel<CCDMethod::FLOATING_POINT_ROOT_PARITY>());
+    case CCDMethod::RATIONAL_FIXED_ROOT_PARITY:
+        return visitor(Kernel<CCDMethod::RATIONAL_FIXED_ROOT_PARITY>());
+    case CCDMethod::BSC:
+        return visitor(Kernel<CCDMethod::BSC>());
+    case CCDMethod::TIGHT_CCD:
+        return visitor(Kernel<CCDMethod::TIGHT_CCD>());
+    case CCDMethod::SAFE_CCD:
+        return visitor(Kernel<CCDMethod::SAFE_CCD>());
+    case CCDMethod::UNIVARIATE_INTERVAL_ROOT_FINDER:
+        return visitor(Kernel<CCDMethod::UNIVARIATE_INTERVAL_ROOT_FINDER>());
+    case CCDMethod::MULTIVARIATE_INTERVAL_ROOT_FINDER:
+        return visitor(Kernel<CCDMethod::MULTIVARIATE_INTERVAL_ROOT_FINDER>());
+    case CCDMethod::TIGHT_INCLUSION:
+        return visitor(Kernel<CCDMethod::TIGHT_INCLUSION>());
+    case CCDMethod::PRECISION_CASCADE:
+        return visitor(Kernel<CCDMethod::PRECISION_CASCADE>());
+    default:
+        // Unreachable after method_status().
+        return visitor(Kernel<CCDMethod::NUM_CCD_METHODS>());
+    }
+}
+
+/**
+ * @brief Check that a method can be run.
+ *
+ * @param method              Method to check.
+ * @param minimum_separation  Whether the method is used for minimum
+ *                            separation CCD.
+ *
+ * @returns CCDStatus::OK if the method can be run, CCDStatus::DISABLED if it
+ *          is not enabled, or CCDStatus::FAILED if it is invalid.
+ */
+inline CCDStatus
+method_status(const CCDMethod method, const bool minimum_separation) noexcept
+{
+    if (method < 0 || method >= CCDMethod::NUM_CCD_METHODS
+        || (minimum_separation && !is_minimum_separation_method(method))) {
+        return CCDStatus::FAILED;
+    }
+    if (!is_method_enabled(method)) {
+        return CCDStatus::DISABLED;
+    }
+    return CCDStatus::OK;
+}
+
+/// Call f(), returning false instead of throwing if it fails.
+template <typename F> bool try_call(F&& f) noexcept
+{
+#if CCD_WRAPPER_HAS_EXCEPTIONS
+    try {
+        f();
+    } catch (...) {
+        return false;
+    }
+#else
+    f();
+#endif
+    return true;
+}
+
+/// Whether a filter proves a query collision free without running the kernel.
+/// Queries without a filter are never rejected. The root parity methods are
+/// filtered by default (see setRootParityFilter), all methods when their
+/// non-penetration filter is enabled, and queries without relative motion
+/// unless the zero-motion fast path is disabled. Coplanarity only implies a
+/// collision for a zero minimum separation, so the non-penetration filter
+/// skips the queries with a positive one.
+template <typename Kernel, typename... Args>
+bool filter_rejects(const Kernel&, const CCDMethod, const Args&...)
+{
+    return false;
+}
+
+template <CCDMethod M>
+bool filter_rejects(
+    const VertexFaceCCD<M>&,
+    const CCDMethod method,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return (plain_min_distance(M) == 0
+            && non_penetration_filter_rejects(
+                method, x0_start, x1_start, x2_start, x3_start, x0_end,
+                x1_end, x2_end, x3_end))
+        || root_parity_filter_rejects(
+               method, /*num_first_points=*/1,
+               { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+                 &x2_end, &x3_end })
+        || zero_motion_rejects(
+               /*num_first_points=*/1, plain_min_distance(M),
+               { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+                 &x2_end, &x3_end });
+}
+
+template <CCDMethod M>
+bool filter_rejects(
+    const EdgeEdgeCCD<M>&,
+    const CCDMethod method,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return (plain_min_distance(M) == 0
+            && non_penetration_filter_rejects(
+                method, x0_start, x1_start, x2_start, x3_start, x0_end,
+                x1_end, x2_end, x3_end))
+        || root_parity_filter_rejects(
+               method, /*num_first_points=*/2,
+               { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+                 &x2_end, &x3_end })
+        || zero_motion_rejects(
+               /*num_first_points=*/2, plain_min_distance(M),
+               { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+                 &x2_end, &x3_end });
+}
+
+// The zero-motion fast path compares with the minimum separation distance.
+template <CCDMethod M>
+bool filter_rejects(
+    const VertexFaceMSCCD<M>&,
+    const CCDMethod method,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double min_distance,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return (min_distance == 0
+            && non_penetration_filter_rejects(
+                method, x0_start, x1_start, x2_start, x3_start, x0_end,
+                x1_end, x2_end, x3_end))
+        || zero_motion_rejects(
+               /*num_first_points=*/1, min_distance,
+               { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+                 &x2_end, &x3_end });
+}
+
+template <CCDMethod M>
+bool filter_rejects(
+    const EdgeEdgeMSCCD<M>&,
+    const CCDMethod method,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double min_distance,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return (min_distance == 0
+            && non_penetration_filter_rejects(
+                method, x0_start, x1_start, x2_start, x3_start, x0_end,
+                x1_end, x2_end, x3_end))
+        || zero_motion_rejects(
+               /*num_first_points=*/2, min_distance,
+               { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+                 &x2_end, &x3_end });
+}
+
+/**
+ * @brief Answer a query against a static obstacle with a specialised kernel
+ *        (see ccd_obstacle.hpp).
+ *
+ * @param num_first_points  Number of points of the first primitive: 1 for
+ *                          vertex-face and 2 for edge-edge queries.
+ * @param x                 Start then end points of the query.
+ * @param t_max             Only collisions in [0, t_max] are reported.
+ * @param hit               Whether the query collides, if it was decided.
+ * @param toi               Lower bound of the time of impact of a hit.
+ * @param output_tolerance  Width of the bracket of the time of impact.
+ *
+ * @returns True if the kernel decided the query.
+ */
+inline bool static_obstacle_decides(
+    const int num_first_points,
+    const Eigen::Vector3d* const (&x)[8],
+    const double t_max,
+    bool& hit,
+    double& toi,
+    double& output_tolerance)
+{
+    if (!static_obstacle_flag().load(std::memory_order_relaxed)) {
+        return false;
+    }
+    const ObstacleAnswer answer = static_obstacle_query(num_first_points, x);
+    switch (answer.kind) {
+    case ObstacleAnswer::NO_HIT:
+        hit = false;
+        return true;
+    case ObstacleAnswer::HIT:
+        if (answer.toi_upper <= t_max) {
+            hit = true;
+            toi = answer.toi_lower;
+            output_tolerance = answer.toi_upper - answer.toi_lower;
+            return true;
+        }
+        if (answer.toi_lower > t_max) {
+            hit = false;
+            return true;
+        }
+        return false;
+    default:
+        return false;
+    }
+}
+
+/// Whether a specialised kernel answered a query against a static obstacle
+/// without running the kernel of the method. Only the queries with a zero
+/// minimum separation are specialised, which excludes the plain kernels of
+/// MIN_SEPARATION_ROOT_FINDER (see plain_min_distance).
+template <typename Kernel, typename... Args>
+bool obstacle_decides(
+    const Kernel&,
+    const double,
+    bool&,
+    double&,
+    double&,
+    const Args&...)
+{
+    return false;
+}
+
+template <CCDMethod M>
+bool obstacle_decides(
+    const VertexFaceCCD<M>&,
+    const double t_max,
+    bool& hit,
+    double& toi,
+    double& output_tolerance,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return plain_min_distance(M) == 0
+        && static_obstacle_decides(
+            /*num_first_points=*/1,
+            { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+              &x2_end, &x3_end },
+            t_max, hit, toi, output_tolerance);
+}
+
+template <CCDMethod M>
+bool obstacle_decides(
+    const EdgeEdgeCCD<M>&,
+    const double t_max,
+    bool& hit,
+    double& toi,
+    double& output_tolerance,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return plain_min_distance(M) == 0
+        && static_obstacle_decides(
+            /*num_first_points=*/2,
+            { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+              &x2_end, &x3_end },
+            t_max, hit, toi, output_tolerance);
+}
+
+template <CCDMethod M>
+bool obstacle_decides(
+    const VertexFaceMSCCD<M>&,
+    const double t_max,
+    bool& hit,
+    double& toi,
+    double& output_tolerance,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double min_distance,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return min_distance == 0
+        && static_obstacle_decides(
+            /*num_first_points=*/1,
+            { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+              &x2_end, &x3_end },
+            t_max, hit, toi, output_tolerance);
+}
+
+template <CCDMethod M>
+bool obstacle_decides(
+    const EdgeEdgeMSCCD<M>&,
+    const double t_max,
+    bool& hit,
+    double& toi,
+    double& output_tolerance,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const double min_distance,
+    const double /*tolerance*/,
+    const long /*max_iter*/,
+    const Eigen::Array3d& /*err*/)
+{
+    return min_distance == 0
+        && static_obstacle_decides(
+            /*num_first_points=*/2,
+            { &x0_start, &x1_start, &x2_start, &x3_start, &x0_end, &x1_end,
+              &x2_end, &x3_end },
+            t_max, hit, toi, output_tolerance);
+}
+
+/// Call a kernel on queries that are not normalised (e.g., single precision).
+template <typename Kernel, typename... Args>
+bool call_kernel(
+    const Kernel& kernel,
+    const double t_max,
+    double& toi,
+    double& output_tolerance,
+    const Args&... args)
+{
+    return kernel(args..., t_max, toi, output_tolerance);
+}
+
+/// Call a kernel on a query translated to a local origin if the normalisation
+/// is enabled (see ccd_normalization.hpp).
+template <typename Kernel, typename... Params>
+bool call_kernel(
+    const Kernel& kernel,
+    const double t_max,
+    double& toi,
+    double& output_tolerance,
+    const Eigen::Vector3d& x0_start,
+    const Eigen::Vector3d& x1_start,
+    const Eigen::Vector3d& x2_start,
+    const Eigen::Vector3d& x3_start,
+    const Eigen::Vector3d& x0_end,
+    const Eigen::Vector3d& x1_end,
+    const Eigen::Vector3d& x2_end,
+    const Eigen::Vector3d& x3_end,
+    const Params&... params)
+{
+    if (!normalization_flag().load(std::memory_order_relaxed)) {
+        return kernel(
+            x0_start, x1_start, x2_start, x3_start, x0_end, x1_end, x2_end,
+            x3_end, params..., t_max, toi, output_tolerance);
+    }
+    Eigen::Vector3d x[8] = { x0_start, x1_start, x2_start, x3_start,
+                             x0_end,   x1_end,   x2_end,   x3_end };
+    NormalizationCounters::increment(0);
+    if (normalize_query(x)) {
+        NormalizationCounters::increment(1);
+    }
+    return kernel(
+        x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7], params..., t_max, toi,
+        output_tolerance);
+}
+
+/**
+ * @brief Run a single query with a resolved kernel without throwing.
+ *
+ * Queries rejected by an enabled filter (see ccd_filters.hpp) return
+ * CCDStatus::OK without running the kernel, and queries against static
+ * obstacles decided by a specialised kernel (see ccd_obstacle.hpp) return its
+ * answer. Other queries are normalised before running the kernel if enabled
+ * (see ccd_normalization.hpp).
+ *
+ * @param kernel            Kernel of the method.
+ * @param method            Method of the kernel.
+ * @param t_max             Forwarded to the kernel.
+ * @param toi               Time of impact computed by the kernel.
+ * @param output_tolerance  Output tolerance computed by the kernel.
+ * @param args              Points and parameters forwarded to the kernel.
+ *
+ * @returns CCDStatus::OK, CCDStatus::HIT, CCDStatus::TOI_OUT_OF_RANGE if a
+ *          computed time of impact is outside [0, 1], or CCDStatus::FAILED if
+ *          the kernel threw.
+ */
+template <typename Kernel, typename... Args>
+CCDStatus query_status(
+    const Kernel& kernel,
+    const CCDMethod method,
+    const double t_max,
+    double& toi,
+    double& output_tolerance,
+    const Args&... args) noexcept
+{
+    if (filter_rejects(kernel, method, args...)) {
+        return CCDStatus::OK;
+    }
+    bool hit;
+    if (!obstacle_decides(kernel, t_max, hit, toi, output_tolerance, args...)
+        && !try_call(
+            [&] {
+                hit = call_kernel(
+                    kernel, t_max, toi, output_tolerance, args...);
+            })) {
+        return CCDStatus::FAILED;
+    }
+    if (!hit) {
+        return CCDStatus::OK;
+    }
+    if (is_time_of_impact_computed(method) && !(toi >= 0 && toi <= 1)) {
+        return CCDStatus::TOI_OUT_OF_RANGE;
+    }
+    return CCDStatus::HIT;
+}
+
+/// Whether a status should be answered conservatively.
+inline bool is_failure(const CCDStatus status)
+{
+    return status == CCDStatus::DISABLED || status == CCDStatus::FAILED
+        || status == CCDStatus::TOI_OUT_OF_RANGE;
+}
+
+/// Report a failed query on std::cerr. The caller answers conservatively.
+inline void report_failure(
+    const char* query_type, const CCDMethod method, const CCDStatus status)
+{
+    if (method < 0 || method >= CCDMethod::NUM_CCD_METHODS) {
+        std::cerr << query_type << " CCD failed because \"Invalid CCDMethod\""
+                  << std::endl;
+        return;
+    }
+    switch (status) {
+    case CCDStatus::DISABLED:
+        std::cerr << query_type
+                  << " CCD failed because \"CCD method is not enabled\" for "
+                  << method_names[method] << std::endl;
+        break;
+    case CCDStatus::TOI_OUT_OF_RANGE:
+        std::cerr << query_type
+                  << " CCD failed because \"toi out of range\" for "
+                  << method_names[method] << std::endl;
+        break;
+    default:
+        std::cerr << query_type
+                  << " CCD failed for unknown reason when using "
+                  << method_names[method] << std::endl;
+    }
+}
+
+/// Fill a result from the outputs of a kernel.
+inline void set_result(
+    const CCDMethod method,
+    const bool hit,
+    const double toi,
+    const double output_tolerance,
+    CCDResult& result)
+{
+    result.hit = hit;
+    if (!hit) {
+        result.toi = std::numeric_limits<double>::infinity();
+    } else if (is_time_of_impact_computed(method)) {
+        result.toi = toi;
+    } else {
+        result.toi = 0; // Conservative
+    }
+    result.output_tolerance = output_tolerance;
+}
+
+/// Conservative result of a failed query.
+inline void set_failed_result(CCDResult& result)
+{
+    result.hit = true;
+    result.toi = 0;
+    result.output_tolerance = 0;
+}
+
+/**
+ * @brief Run a single query with a resolved kernel without throwing.
+ *
+ * @param  kernel  Kernel of the method.
+ * @param  method  Method of the kernel.
+ * @param  result  Result of the query, conservative upon failure.
+ * @param  args    Points and parameters forwarded to the kernel.
+ *
+ * @returns Status of the query.
+ */
+template <typename Kernel, typename... Args>
+CCDStatus run_kernel(
+    const Kernel& kernel,
+    const CCDMethod method,
+    CCDResult& result,
+    const Args&... args) noexcept
+{
+    double toi = std::numeric_limits<double>::infinity();
+    double output_tolerance = 0;
+    const CCDStatus status = query_status(
+        kernel, method, /*t_max=*/1.0, toi, output_tolerance, args...);
+    if (is_failure(status)) {
+        set_failed_result(result);
+    } else {
+        set_result(
+            method, status == CCDStatus::HIT, toi, output_tolerance, result);
+    }
+    return status;
+}
+
+/**
+ * @brief Dispatch the method and run a single query without throwing.
+ *
+ * @tparam Kernel  One of the kernel templates above.
+ * @param  result  Result of the query, conservative upon failure.
+ * @param  args    Points and parameters forwarded to the kernel.
+ *
+ * @returns Status of the query.
+ */
+template <template <CCDMethod> class Kernel, typename... Args>
+CCDStatus run_query(
+    const CCDMethod method, CCDResult& result, const Args&... args) noexcept
+{
+    const CCDStatus status =
+        method_status(method, is_minimum_separation_kernel<Kernel>::value);
+    if (status != CCDStatus::OK) {
+        set_failed_result(result);
+        return status;
+    }
+    return dispatch<Kernel>(method, [&](const auto& kernel) {
+        return run_kernel(kernel, method, result, args...);
+    });
+}
+
+/// Store the outputs of a kernel for the i-th query.
+inline void store(
+    bool* hits,
+    const size_t i,
+    const CCDMethod method,
+    const bool hit,
+    const double toi,
+    const double output_tolerance)
+{
+    hits[i] = hit;
+}
+
+inline void store(
+    CCDResult* results,
+    const size_t i,
+    const CCDMethod method,
+    const bool hit,
+    const double toi,
+    const double output_tolerance)
+{
+    set_result(method, hit, toi, output_tolerance, results[i]);
+}
+
+/// Store the conservative answer for the i-th query.
+inline void store_failure(bool* hits, const size_t i) { hits[i] = true; }
+
+inline void store_failure(CCDResult* results, const size_t i)
+{
+    set_failed_result(results[i]);
+}
+
+/// Output of a batch that only records whether some query collides. It can
+/// be shared by the threads running parts of a batch, which all stop once a
+/// collision is found.
+struct AnyHit {
+    std::atomic<bool>& found;
+};
+
+inline void store(
+    AnyHit* any,
+    const size_t i,
+    const CCDMethod method,
+    const bool hit,
+    const double toi,
+    const double output_tolerance)
+{
+    if (hit) {
+        any->found.store(true, std::memory_order_relaxed);
+    }
+}
+
+inline void store_failure(AnyHit* any, const size_t i)
+{
+    any->found.store(true, std::memory_order_relaxed);
+}
+
+/// Whether the remaining queries of a batch can be skipped.
+inline bool is_batch_done(const bool* hits) { return false; }
+
+inline bool is_batch_done(const CCDResult* results) { return false; }
+
+inline bool is_batch_done(const AnyHit* any)
+{
+    return any->found.load(std::memory_order_relaxed);
+}
+
+/// Number of points of the first primitive of a kernel template's queries.
+template <template <CCDMethod> class Kernel> struct num_first_points;
+template <> struct num_first_points<VertexFaceCCD> {
+    static const int value = 1;
+};
+template <> struct num_first_points<EdgeEdgeCCD> {
+    static const int value = 2;
+};
+template <> struct num_first_points<VertexFaceMSCCD> {
+    static const int value = 1;
+};
+template <> struct num_first_points<EdgeEdgeMSCCD> {
+    static const int value = 2;
+};
+
+/// Distance by which the swept bounding boxes of a batch are inflated: the
+/// minimum separation distance, which is the first parameter after the points
+/// of the minimum separation kernels, or the one the plain kernels of the
+/// method run with.
+template <template <CCDMethod> class Kernel, typename... Params>
+double cull_distance(
+    const CCDMethod method, const double first_param, const Params&...)
+{
+    return is_minimum_separation_kernel<Kernel>::value
+        ? first_param
+        : plain_min_distance(method);
+}
+
+/// Number of queries of a batch culled at once.
+static const size_t CULL_BLOCK_SIZE = 64;
+
+/**
+ * @brief Dispatch the method once and run all queries with the resolved
+ *        kernel.
+ *
+ * Queries are culled in blocks with their swept bounding boxes (see
+ * ccd_culling.hpp), and only the survivors run the kernel. Culled queries do
+ * not collide. Failed queries are reported and answered conservatively. The
+ * remaining queries are skipped once is_batch_done(outputs).
+ *
+ * @tparam Kernel       One of the kernel templates above.
+ * @param  num_queries  Number of queries.
+ * @param  gather       Callable filling the eight points of the i-th query,
+ *                      gather(i, x) with Eigen::Vector3d x[8], in the order of
+ *                      the kernel arguments.
+ * @param  outputs      Array of num_queries bool or CCDResult, or an AnyHit.
+ * @param  params       Forwarded to the kernel after the points.
+ */
+template <
+    template <CCDMethod> class Kernel,
+    typename Gather,
+    typename Output,
+    typename... Params>
+void run_batch(
+    const char* query_type,
+    const size_t num_queries,
+    const CCDMethod method,
+    Gather&& gather,
+    Output* outputs,
+    const Params&... params)
+{
+    const CCDStatus status =
+        method_status(method, is_minimum_separation_kernel<Kernel>::value);
+    if (status != CCDStatus::OK) {
+        // Conservative answer upon failure.
+        if (num_queries > 0) {
+            report_failure(query_type, method, status);
+        }
+        for (size_t i = 0; i < num_queries; i++) {
+            store_failure(outputs, i);
+        }
+        return;
+    }
+
+    const double min_distance = cull_distance<Kernel>(method, params...);
+    const SIMDLevel simd_level = detectedSIMDLevel();
+
+    dispatch<Kernel>(method, [&](const auto& kernel) {
+        // Coordinates of the eight points of a block of queries in SoA form
+        double coordinates[24 * CULL_BLOCK_SIZE];
+        size_t survivors[CULL_BLOCK_SIZE];
+        Eigen::Vector3d x[8];
+
+        for (size_t begin = 0; begin < num_queries && !is_batch_done(outputs);
+             begin += CULL_BLOCK_SIZE) {
+            const size_t block_size =
+                std::min(CULL_BLOCK_SIZE, num_queries - begin);
+            for (size_t i = 0; i < block_size; i++) {
+                gather(begin + i, x);
+                for (int j = 0; j < 8; j++) {
+                    for (int k = 0; k < 3; k++) {
+                        coordinates[(3 * j + k) * CULL_BLOCK_SIZE + i] =
+                            x[j][k];
+                    }
+                }
+            }
+            const size_t num_survivors = cull_swept_boxes(
+                coordinates, CULL_BLOCK_SIZE, block_size,
+                num_first_points<Kernel>::value, min_distance, survivors,
+                simd_level);
+            count_culled(block_size, block_size - num_survivors);
+
+            size_t s = 0;
+            for (size_t i = 0; i < block_size; i++) {
+                if (s == num_survivors || survivors[s] != i) {
+                    store(
+                        outputs, begin + i, method, /*hit=*/false,
+                        std::numeric_limits<double>::infinity(), 0);
+                    continue;
+                }
+                s++;
+                if (is_batch_done(outputs)) {
+                    break;
+                }
+                for (int j = 0; j < 8; j++) {
+                    for (int k = 0; k < 3; k++) {
+                        x[j][k] =
+                            coordinates[(3 * j + k) * CULL_BLOCK_SIZE + i];
+                    }
+                }
+                // Kernels and filters only write the outputs they compute.
+                double toi = std::numeric_limits<double>::infinity();
+                double output_tolerance = 0;
+                const CCDStatus query = query_status(
+                    kernel, method, /*t_max=*/1.0, toi, output_tolerance, x[0],
+                    x[1], x[2], x[3], x[4], x[5], x[6], x[7], params...);
+                if (is_failure(query)) {
+                    // Conservative answer upon failure.
+                    report_failure(query_type, method, query);
+                    store_failure(outputs, begin + i);
+                } else {
+                    store(
+                        outputs, begin + i, method, query == CCDStatus::HIT,
+                        toi, output_tolerance);
+                }
+            }
+        }
+    });
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Single precision
+
+/// Whether a method runs natively on float points in this build. Only Tight
+/// Inclusion built without TIGHT_INCLUSION_WITH_DOUBLE_PRECISION does.
+constexpr bool is_native_float_method(const CCDMethod method)
+{
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION && !defined(TIGHT_INCLUSION_WITH_DOUBLE_PRECISION)
+    return method == CCDMethod::TIGHT_INCLUSION;
+#else
+    return false;
+#endif
+}
+
+/// Convert the points and parameters of a float query to double. Exact, so the
+/// promoted query is the same query.
+inline Eigen::Vector3d promote(const Eigen::Vector3f& x)
+{
+    return x.cast<double>();
+}
+inline Eigen::Array3d promote(const Eigen::Array3f& x)
+{
+    return x.cast<double>();
+}
+inline double promote(const float x) { return x; }
+inline long promote(const long x) { return x; }
+
+/// Native single precision adapter of a kernel template (Tight Inclusion).
+template <template <CCDMethod> class Kernel> struct FloatKernel;
+
+template <> struct FloatKernel<VertexFaceMSCCD> {
+    bool operator()(
+        const Eigen::Vector3f& vertex_start,
+        const Eigen::Vector3f& face_vertex0_start,
+        const Eigen::Vector3f& face_vertex1_start,
+        const Eigen::Vector3f& face_vertex2_start,
+        const Eigen::Vector3f& vertex_end,
+        const Eigen::Vector3f& face_vertex0_end,
+        const Eigen::Vector3f& face_vertex1_end,
+        const Eigen::Vector3f& face_vertex2_end,
+        const float min_distance,
+        const float tolerance,
+        const long max_iter,
+        const Eigen::Array3f& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION && !defined(TIGHT_INCLUSION_WITH_DOUBLE_PRECISION)
+        // 0: normal ccd method which only checks t = [0,1]
+        // 1: ccd with max_itr and t=[0, t_max]
+        const int CCD_TYPE = 1;
+        float toi_f = std::numeric_limits<float>::infinity();
+        float output_tolerance_f = 0;
+        const bool hit = ticcd::vertexFaceCCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            err,                // rounding error
+            min_distance,       // minimum separation distance
+            toi_f,              // time of impact
+            tolerance,          // delta
+            float(t_max),       // Maximum time to check
+            max_iter,           // Maximum number of iterations
+            output_tolerance_f, // delta_actual
+            CCD_TYPE);
+        toi = toi_f;
+        output_tolerance = output_tolerance_f;
+        return hit;
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct FloatKernel<EdgeEdgeMSCCD> {
+    bool operator()(
+        const Eigen::Vector3f& edge0_vertex0_start,
+        const Eigen::Vector3f& edge0_vertex1_start,
+        const Eigen::Vector3f& edge1_vertex0_start,
+        const Eigen::Vector3f& edge1_vertex1_start,
+        const Eigen::Vector3f& edge0_vertex0_end,
+        const Eigen::Vector3f& edge0_vertex1_end,
+        const Eigen::Vector3f& edge1_vertex0_end,
+        const Eigen::Vector3f& edge1_vertex1_end,
+        const float min_distance,
+        const float tolerance,
+        const long max_iter,
+        const Eigen::Array3f& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION && !defined(TIGHT_INCLUSION_WITH_DOUBLE_PRECISION)
+        // 0: normal ccd method which only checks t = [0,1]
+        // 1: ccd with max_itr and t=[0, t_max]
+        const int CCD_TYPE = 1;
+        float toi_f = std::numeric_limits<float>::infinity();
+        float output_tolerance_f = 0;
+        const bool hit = ticcd::edgeEdgeCCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            err,                // rounding error
+            min_distance,       // minimum separation distance
+            toi_f,              // time of impact
+            tolerance,          // delta
+            float(t_max),       // Maximum time to check
+            max_iter,           // Maximum number of iterations
+            output_tolerance_f, // delta_actual
+            CCD_TYPE);
+        toi = toi_f;
+        output_tolerance = output_tolerance_f;
+        return hit;
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct FloatKernel<VertexFaceCCD> {
+    bool operator()(
+        const Eigen::Vector3f& vertex_start,
+        const Eigen::Vector3f& face_vertex0_start,
+        const Eigen::Vector3f& face_vertex1_start,
+        const Eigen::Vector3f& face_vertex2_start,
+        const Eigen::Vector3f& vertex_end,
+        const Eigen::Vector3f& face_vertex0_end,
+        const Eigen::Vector3f& face_vertex1_end,
+        const Eigen::Vector3f& face_vertex2_end,
+        const float tolerance,
+        const long max_iter,
+        const Eigen::Array3f& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return FloatKernel<VertexFaceMSCCD>()(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            /*minimum_distance=*/0, tolerance, max_iter, err, t_max,
+            toi, output_tolerance);
+    }
+};
+
+template <> struct FloatKernel<EdgeEdgeCCD> {
+    bool operator()(
+        const Eigen::Vector3f& edge0_vertex0_start,
+        const Eigen::Vector3f& edge0_vertex1_start,
+        const Eigen::Vector3f& edge1_vertex0_start,
+        const Eigen::Vector3f& edge1_vertex1_start,
+        const Eigen::Vector3f& edge0_vertex0_end,
+        const Eigen::Vector3f& edge0_vertex1_end,
+        const Eigen::Vector3f& edge1_vertex0_end,
+        const Eigen::Vector3f& edge1_vertex1_end,
+        const float tolerance,
+        const long max_iter,
+        const Eigen::Array3f& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return FloatKernel<EdgeEdgeMSCCD>()(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            /*minimum_distance=*/0, tolerance, max_iter, err, t_max,
+            toi, output_tolerance);
+    }
+};
+
+/// Round up to the nearest float.
+inline float round_up(const double x)
+{
+    const float f = static_cast<float>(x);
+    return f < x ? std::nextafter(f, std::numeric_limits<float>::infinity())
+                 : f;
+}
+
+/**
+ * @brief Run a double minimum separation query with a native single
+ *        precision adapter.
+ *
+ * Rounding the points to float moves each primitive by at most the largest
+ * rounding error e of a point, so the distance between the primitives changes
+ * by at most 2e. Enlarging the minimum separation distance by 2e keeps the
+ * rounded query conservative.
+ *
+ * @param kernel  FloatKernel of a minimum separation kernel template.
+ * @param points  Start and end points of the query in the kernel's order.
+ *
+ * @returns True if the rounded query collides.
+ */
+template <typename Kernel>
+bool run_demoted(
+    const Kernel& kernel,
+    const Eigen::Vector3d* const (&points)[8],
+    const double min_distance,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err,
+    const double t_max,
+    double& toi,
+    double& output_tolerance)
+{
+    Eigen::Vector3f x[8];
+    double max_error = 0;
+    for (int i = 0; i < 8; i++) {
+        x[i] = points[i]->cast<float>();
+        max_error =
+            std::max(max_error, (x[i].cast<double>() - *points[i]).norm());
+    }
+    // Negative err means Tight Inclusion computes it.
+    Eigen::Array3f float_err(-1, 0, 0);
+    if (err[0] >= 0) {
+        for (int i = 0; i < 3; i++) {
+            float_err[i] = round_up(err[i]);
+        }
+    }
+    const double float_min_distance = std::nextafter(
+        min_distance + 2 * max_error, std::numeric_limits<double>::infinity());
+    return kernel(
+        x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7],
+        round_up(float_min_distance), static_cast<float>(tolerance), max_iter,
+        float_err, t_max, toi, output_tolerance);
+}
+
+/**
+ * @brief Run a single float query without throwing.
+ *
+ * Runs the native single precision adapter if the method has one, and
+ * otherwise the double kernel on the promoted query.
+ *
+ * @tparam Kernel  One of the kernel templates above.
+ * @param  result  Result of the query, conservative upon failure.
+ * @param  args    Float points and parameters forwarded to the kernel.
+ *
+ * @returns Status of the query.
+ */
+template <template <CCDMethod> class Kernel, typename... Args>
+CCDStatus run_float_query(
+    const CCDMethod method, CCDResult& result, const Args&... args) noexcept
+{
+    if (is_native_float_method(method)) {
+        return run_kernel(FloatKernel<Kernel>(), method, result, args...);
+    }
+    return run_query<Kernel>(method, result, promote(args)...);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+// Vertex-face
+
+template <> struct VertexFaceCCD<CCDMethod::FLOATING_POINT_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_FPRF
+        return CTCD::vertexFaceCTCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            /*eta=*/0, toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceMSCCD<CCDMethod::MIN_SEPARATION_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double min_distance,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_MSRF
+        return msccd::root_finder::vertexFaceMSCCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            min_distance, toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::MIN_SEPARATION_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return VertexFaceMSCCD<CCDMethod::MIN_SEPARATION_ROOT_FINDER>()(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            /*minimum_distance=*/DEFAULT_MIN_DISTANCE, tolerance, max_iter,
+            err, t_max, toi, output_tolerance);
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_RP
+        return rootparity::RootParityCollisionTest(
+                   // Point at t=0
+                   Vec3d(vertex_start.data()),
+                   // Triangle at t = 0
+                   Vec3d(face_vertex1_start.data()),
+                   Vec3d(face_vertex0_start.data()),
+                   Vec3d(face_vertex2_start.data()),
+                   // Point at t=1
+                   Vec3d(vertex_end.data()),
+                   // Triangle at t = 1
+                   Vec3d(face_vertex1_end.data()),
+                   Vec3d(face_vertex0_end.data()),
+                   Vec3d(face_vertex2_end.data()),
+                   /* is_edge_edge = */ false)
+            .run_test();
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::RATIONAL_ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_RRP
+        return eccd::vertexFaceCCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::FLOATING_POINT_ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_FPRP
+        return doubleccd::vertexFaceCCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::RATIONAL_FIXED_ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_RFRP
+        return ccd::vertexFaceCCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceMSCCD<CCDMethod::TIGHT_INCLUSION> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double min_distance,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION && defined(TIGHT_INCLUSION_WITH_DOUBLE_PRECISION)
+        // 0: normal ccd method which only checks t = [0,1]
+        // 1: ccd with max_itr and t=[0, t_max]
+        const int CCD_TYPE = 1;
+        return ticcd::vertexFaceCCD(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            err,              // rounding error
+            min_distance,     // minimum separation distance
+            toi,              // time of impact
+            tolerance,        // delta
+            t_max,            // Maximum time to check
+            max_iter,         // Maximum number of iterations
+            output_tolerance, // delta_actual
+            CCD_TYPE);
+#elif CCD_WRAPPER_WITH_TIGHT_INCLUSION
+        // Tight Inclusion is built in single precision.
+        return run_demoted(
+            FloatKernel<VertexFaceMSCCD>(),
+            {
+                &vertex_start, &face_vertex0_start, &face_vertex1_start,
+                &face_vertex2_start, &vertex_end, &face_vertex0_end,
+                &face_vertex1_end, &face_vertex2_end },
+            min_distance, tolerance, max_iter, err, t_max, toi,
+            output_tolerance);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::TIGHT_INCLUSION> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return VertexFaceMSCCD<CCDMethod::TIGHT_INCLUSION>()(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            /*minimum_distance=*/0, tolerance, max_iter, err, t_max,
+            toi, output_tolerance);
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::BSC> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_BSC
+        return bsc::Intersect_VF_robust(
+            // Triangle at t = 0
+            Vec3d(face_vertex0_start.data()), Vec3d(face_vertex1_start.data()),
+            Vec3d(face_vertex2_start.data()),
+            // Point at t=0
+            Vec3d(vertex_start.data()),
+            // Triangle at t = 1
+            Vec3d(face_vertex0_end.data()), Vec3d(face_vertex1_end.data()),
+            Vec3d(face_vertex2_end.data()),
+            // Point at t=1
+            Vec3d(vertex_end.data()));
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::TIGHT_CCD> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_CCD
+        return bsc_tightbound::Intersect_VF_robust(
+            // Triangle at t = 0
+            Vec3d(face_vertex0_start.data()), Vec3d(face_vertex1_start.data()),
+            Vec3d(face_vertex2_start.data()),
+            // Point at t=0
+            Vec3d(vertex_start.data()),
+            // Triangle at t = 1
+            Vec3d(face_vertex0_end.data()), Vec3d(face_vertex1_end.data()),
+            Vec3d(face_vertex2_end.data()),
+            // Point at t=1
+            Vec3d(vertex_end.data()));
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::SAFE_CCD> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_SAFE_CCD
+        double b = safeccd::calculate_B(
+            vertex_start.data(), face_vertex0_start.data(),
+            face_vertex1_start.data(), face_vertex2_start.data(),
+            vertex_end.data(), face_vertex0_end.data(), face_vertex1_end.data(),
+            face_vertex2_end.data(), false);
+        safeccd::SAFE_CCD<double> safe;
+        safe.Set_Coefficients(b);
+        double t, u[3], v[3];
+        double vs[3], ve[3], f0s[3], f0e[3], f1s[3], f1e[3], f2s[3], f2e[3];
+        for (int i = 0; i < 3; i++) {
+            vs[i] = vertex_start[i];
+            ve[i] = vertex_end[i];
+            f0s[i] = face_vertex0_start[i];
+            f0e[i] = face_vertex0_end[i];
+            f1s[i] = face_vertex1_start[i];
+            f1e[i] = face_vertex1_end[i];
+            f2s[i] = face_vertex2_start[i];
+            f2e[i] = face_vertex2_end[i];
+        }
+        return safe.Vertex_Triangle_CCD(
+            vs, ve, f0s, f0e, f1s, f1e, f2s, f2e, t, u, v);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::UNIVARIATE_INTERVAL_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_INTERVAL
+        return intervalccd::vertexFaceCCD_Redon(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            // Time of impact
+            toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct VertexFaceCCD<CCDMethod::MULTIVARIATE_INTERVAL_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_INTERVAL
+        return intervalccd::vertexFaceCCD_Interval(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            // Time of impact
+            toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Edge-edge
+
+template <> struct EdgeEdgeCCD<CCDMethod::FLOATING_POINT_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_FPRF
+        return CTCD::edgeEdgeCTCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            /*eta=*/0, toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeMSCCD<CCDMethod::MIN_SEPARATION_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double min_distance,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_MSRF
+        return msccd::root_finder::edgeEdgeMSCCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end, min_distance, toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::MIN_SEPARATION_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return EdgeEdgeMSCCD<CCDMethod::MIN_SEPARATION_ROOT_FINDER>()(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            /*minimum_distance=*/DEFAULT_MIN_DISTANCE, tolerance, max_iter,
+            err, t_max, toi, output_tolerance);
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_RP
+        return rootparity::RootParityCollisionTest(
+                   // Edge 1 at t=0
+                   Vec3d(edge0_vertex0_start.data()),
+                   Vec3d(edge0_vertex1_start.data()),
+                   // Edge 2 at t=0
+                   Vec3d(edge1_vertex0_start.data()),
+                   Vec3d(edge1_vertex1_start.data()),
+                   // Edge 1 at t=1
+                   Vec3d(edge0_vertex0_end.data()),
+                   Vec3d(edge0_vertex1_end.data()),
+                   // Edge 2 at t=1
+                   Vec3d(edge1_vertex0_end.data()),
+                   Vec3d(edge1_vertex1_end.data()),
+                   /* is_edge_edge = */ true)
+            .run_test();
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::RATIONAL_ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_RRP
+        return eccd::edgeEdgeCCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::FLOATING_POINT_ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_FPRP
+        return doubleccd::edgeEdgeCCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::RATIONAL_FIXED_ROOT_PARITY> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_RFRP
+        return ccd::edgeEdgeCCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeMSCCD<CCDMethod::TIGHT_INCLUSION> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double min_distance,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION && defined(TIGHT_INCLUSION_WITH_DOUBLE_PRECISION)
+        // 0: normal ccd method which only checks t = [0,1]
+        // 1: ccd with max_itr and t=[0, t_max]
+        const int CCD_TYPE = 1;
+        return ticcd::edgeEdgeCCD(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            err,              // rounding error
+            min_distance,     // minimum separation distance
+            toi,              // time of impact
+            tolerance,        // delta
+            t_max,            // Maximum time to check
+            max_iter,         // Maximum number of iterations
+            output_tolerance, // delta_actual
+            CCD_TYPE);
+#elif CCD_WRAPPER_WITH_TIGHT_INCLUSION
+        // Tight Inclusion is built in single precision.
+        return run_demoted(
+            FloatKernel<EdgeEdgeMSCCD>(),
+            {
+                &edge0_vertex0_start, &edge0_vertex1_start,
+                &edge1_vertex0_start, &edge1_vertex1_start,
+                &edge0_vertex0_end, &edge0_vertex1_end, &edge1_vertex0_end,
+                &edge1_vertex1_end },
+            min_distance, tolerance, max_iter, err, t_max, toi,
+            output_tolerance);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::TIGHT_INCLUSION> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+        return EdgeEdgeMSCCD<CCDMethod::TIGHT_INCLUSION>()(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            /*minimum_distance=*/0, tolerance, max_iter, err, t_max,
+            toi, output_tolerance);
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::BSC> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_BSC
+        return bsc::Intersect_EE_robust(
+            // Edge 1 at t=0
+            Vec3d(edge0_vertex0_start.data()),
+            Vec3d(edge0_vertex1_start.data()),
+            // Edge 2 at t=0
+            Vec3d(edge1_vertex0_start.data()),
+            Vec3d(edge1_vertex1_start.data()),
+            // Edge 1 at t=1
+            Vec3d(edge0_vertex0_end.data()), Vec3d(edge0_vertex1_end.data()),
+            // Edge 2 at t=1
+            Vec3d(edge1_vertex0_end.data()), Vec3d(edge1_vertex1_end.data()));
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::TIGHT_CCD> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_CCD
+        return bsc_tightbound::Intersect_EE_robust(
+            // Edge 1 at t=0
+            Vec3d(edge0_vertex0_start.data()),
+            Vec3d(edge0_vertex1_start.data()),
+            // Edge 2 at t=0
+            Vec3d(edge1_vertex0_start.data()),
+            Vec3d(edge1_vertex1_start.data()),
+            // Edge 1 at t=1
+            Vec3d(edge0_vertex0_end.data()), Vec3d(edge0_vertex1_end.data()),
+            // Edge 2 at t=1
+            Vec3d(edge1_vertex0_end.data()), Vec3d(edge1_vertex1_end.data()));
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::SAFE_CCD> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_SAFE_CCD
+        double b = safeccd::calculate_B(
+            edge0_vertex0_start.data(), edge0_vertex1_start.data(),
+            edge1_vertex0_start.data(), edge1_vertex1_start.data(),
+            edge0_vertex0_end.data(), edge0_vertex1_end.data(),
+            edge1_vertex0_end.data(), edge1_vertex1_end.data(), true);
+        safeccd::SAFE_CCD<double> safe;
+        safe.Set_Coefficients(b);
+        double t, u[3], v[3];
+        double vs[3], ve[3], f0s[3], f0e[3], f1s[3], f1e[3], f2s[3], f2e[3];
+        for (int i = 0; i < 3; i++) {
+            vs[i] = edge0_vertex0_start[i];
+            ve[i] = edge0_vertex0_end[i];
+            f0s[i] = edge0_vertex1_start[i];
+            f0e[i] = edge0_vertex1_end[i];
+            f1s[i] = edge1_vertex0_start[i];
+            f1e[i] = edge1_vertex0_end[i];
+            f2s[i] = edge1_vertex1_start[i];
+            f2e[i] = edge1_vertex1_end[i];
+        }
+        return safe.Edge_Edge_CCD(
+            vs, ve, f0s, f0e, f1s, f1e, f2s, f2e, t, u, v);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::UNIVARIATE_INTERVAL_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_INTERVAL
+        return intervalccd::edgeEdgeCCD_Redon(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            // Time of impact
+            toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::MULTIVARIATE_INTERVAL_ROOT_FINDER> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_INTERVAL
+        return intervalccd::edgeEdgeCCD_Interval(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            // Time of impact
+            toi);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// Precision cascade
+
+/**
+ * @brief Run a query through the tiers of the precision cascade.
+ *
+ * Tight Inclusion never misses a collision, so its negatives are final. The
+ * coarse tier answers most negatives cheaply, and only its positives run Tight
+ * Inclusion with the tolerance and budget of the query. A positive that
+ * reached the tolerance is final, and one that ran out of iterations first is
+ * checked with rational root parity, which ignores t_max. Without rational
+ * root parity, the Tight Inclusion positive is kept.
+ *
+ * The time of impact and output tolerance are those of Tight Inclusion with
+ * the query's tolerance, so the time of impact is a lower bound.
+ *
+ * @tparam Kernel  VertexFaceCCD or EdgeEdgeCCD.
+ * @param  points  Start and end points of the query in the kernel's order.
+ *
+ * @returns True if the query collides.
+ */
+template <template <CCDMethod> class Kernel>
+bool run_cascade(
+    const Eigen::Vector3d* const (&points)[8],
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err,
+    const double t_max,
+    double& toi,
+    double& output_tolerance)
+{
+    const auto tight_inclusion = [&](const double tier_tolerance,
+                                     const long tier_max_iter) {
+        return Kernel<CCDMethod::TIGHT_INCLUSION>()(
+            *points[0], *points[1], *points[2], *points[3], *points[4],
+            *points[5], *points[6], *points[7], tier_tolerance, tier_max_iter,
+            err, t_max, toi, output_tolerance);
+    };
+    CascadeCounters::increment(CASCADE_QUERIES);
+
+    // A non-positive budget means no limit.
+    const double coarse_tolerance =
+        std::max(tolerance, CASCADE_COARSE_TOLERANCE);
+    const long coarse_max_iter = max_iter > 0
+        ? std::min(max_iter, CASCADE_COARSE_MAX_ITER)
+        : CASCADE_COARSE_MAX_ITER;
+    if ((coarse_tolerance != tolerance || coarse_max_iter != max_iter)
+        && !tight_inclusion(coarse_tolerance, coarse_max_iter)) {
+        CascadeCounters::increment(COARSE_TIGHT_INCLUSION_TIER);
+        return false;
+    }
+
+    const bool hit = tight_inclusion(tolerance, max_iter);
+    if (!hit || output_tolerance <= tolerance) {
+        CascadeCounters::increment(TIGHT_INCLUSION_TIER);
+        return hit;
+    }
+
+    bool exact_hit = hit;
+    if (is_method_enabled(CCDMethod::RATIONAL_ROOT_PARITY)
+        && try_call([&] {
+               double exact_toi, exact_output_tolerance;
+               exact_hit = Kernel<CCDMethod::RATIONAL_ROOT_PARITY>()(
+                   *points[0], *points[1], *points[2], *points[3], *points[4],
+                   *points[5], *points[6], *points[7], tolerance, max_iter,
+                   err, t_max, exact_toi, exact_output_tolerance);
+           })) {
+        CascadeCounters::increment(RATIONAL_ROOT_PARITY_TIER);
+        return exact_hit;
+    }
+    CascadeCounters::increment(CASCADE_UNRESOLVED);
+    return hit;
+}
+
+template <> struct VertexFaceCCD<CCDMethod::PRECISION_CASCADE> {
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION
+        return run_cascade<VertexFaceCCD>(
+            {
+                &vertex_start, &face_vertex0_start, &face_vertex1_start,
+                &face_vertex2_start, &vertex_end, &face_vertex0_end,
+                &face_vertex1_end, &face_vertex2_end },
+            tolerance, max_iter, err, t_max, toi, output_tolerance);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+template <> struct EdgeEdgeCCD<CCDMethod::PRECISION_CASCADE> {
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance,
+        const long max_iter,
+        const Eigen::Array3d& err,
+        const double t_max,
+        double& toi,
+        double& output_tolerance) const
+    {
+#if CCD_WRAPPER_WITH_TIGHT_INCLUSION
+        return run_cascade<EdgeEdgeCCD>(
+            {
+                &edge0_vertex0_start, &edge0_vertex1_start,
+                &edge1_vertex0_start, &edge1_vertex1_start,
+                &edge0_vertex0_end, &edge0_vertex1_end, &edge1_vertex0_end,
+                &edge1_vertex1_end },
+            tolerance, max_iter, err, t_max, toi, output_tolerance);
+#else
+        return unavailable();
+#endif
+    }
+};
+
+} // namespace kernels
+} // namespace ccd
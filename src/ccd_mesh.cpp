@@ -0,0 +1,927 @@
+// CCD of candidate pairs of primitives of a moving mesh
+#include "ccd_mesh.hpp"
+
+#include "ccd_kernels.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <queue>
+
+namespace ccd {
+
+namespace {
+
+    // Copy the points of the i-th vertex-face candidate.
+    struct VertexFaceGather {
+        const Eigen::MatrixXd& V0;
+        const Eigen::MatrixXd& V1;
+        const Eigen::MatrixXi& F;
+        const VertexFaceCandidate* candidates;
+
+        void operator()(const size_t i, Eigen::Vector3d x[8]) const
+        {
+            const long v = candidates[i].vertex_id, f = candidates[i].face_id;
+            x[0] = V0.row(v);
+            x[1] = V0.row(F(f, 0));
+            x[2] = V0.row(F(f, 1));
+            x[3] = V0.row(F(f, 2));
+            x[4] = V1.row(v);
+            x[5] = V1.row(F(f, 0));
+            x[6] = V1.row(F(f, 1));
+            x[7] = V1.row(F(f, 2));
+        }
+    };
+
+    // Copy the points of the i-th edge-edge candidate.
+    struct EdgeEdgeGather {
+        const Eigen::MatrixXd& V0;
+        const Eigen::MatrixXd& V1;
+        const Eigen::MatrixXi& E;
+        const EdgeEdgeCandidate* candidates;
+
+        void operator()(const size_t i, Eigen::Vector3d x[8]) const
+        {
+            const long e0 = candidates[i].edge0_id;
+            const long e1 = candidates[i].edge1_id;
+            x[0] = V0.row(E(e0, 0));
+            x[1] = V0.row(E(e0, 1));
+            x[2] = V0.row(E(e1, 0));
+            x[3] = V0.row(E(e1, 1));
+            x[4] = V1.row(E(e0, 0));
+            x[5] = V1.row(E(e0, 1));
+            x[6] = V1.row(E(e1, 0));
+            x[7] = V1.row(E(e1, 1));
+        }
+    };
+
+    // Lower earliest to the time of impact of the candidates. Each candidate
+    // is only checked up to the earliest time of impact found so far.
+    template <
+        template <CCDMethod> class Kernel,
+        typename Gather,
+        typename... Params>
+    void reduce_earliest_toi(
+        const char* query_type,
+        const size_t num_queries,
+        const CCDMethod method,
+        Gather&& gather,
+        double& earliest,
+        const Params&... params)
+    {
+        if (earliest <= 0) {
+            return;
+        }
+        const CCDStatus status = kernels::method_status(
+            method, kernels::is_minimum_separation_kernel<Kernel>::value);
+        if (status != CCDStatus::OK) {
+            // Conservative answer upon failure.
+            if (num_queries > 0) {
+                kernels::report_failure(query_type, method, status);
+                earliest = 0;
+            }
+            return;
+        }
+
+        kernels::dispatch<Kernel>(method, [&](const auto& kernel) {
+            Eigen::Vector3d x[8];
+            double toi, output_tolerance;
+            for (size_t i = 0; i < num_queries && earliest > 0; i++) {
+                gather(i, x);
+                const CCDStatus query = kernels::query_status(
+                    kernel, method, std::min(earliest, 1.0), toi,
+                    output_tolerance, x[0], x[1], x[2], x[3], x[4], x[5],
+                    x[6], x[7], params...);
+                if (kernels::is_failure(query)) {
+                    // Conservative answer upon failure.
+                    kernels::report_failure(query_type, method, query);
+                    earliest = 0;
+                } else if (query == CCDStatus::HIT) {
+                    earliest = is_time_of_impact_computed(method)
+                        ? std::min(earliest, toi)
+                        : 0; // Conservative
+                }
+            }
+        });
+    }
+
+    // Run a candidate with a tolerance, a budget of iterations, and a maximum
+    // time.
+    using RefinedQuery = std::function<CCDStatus(
+        size_t i,
+        double tolerance,
+        long max_iter,
+        double t_max,
+        double& toi)>;
+
+    // Bind the kernel of a method to the candidates of a gather. The
+    // minimum distance is omitted for the kernels without one.
+    template <
+        template <CCDMethod> class Kernel,
+        typename Gather,
+        typename... Distance>
+    RefinedQuery refined_query(
+        const CCDMethod method,
+        const Gather& gather,
+        const Eigen::Array3d& err,
+        const Distance... min_distance)
+    {
+        RefinedQuery query;
+        kernels::dispatch<Kernel>(method, [&](const auto& kernel) {
+            query = [=](
+                        const size_t i, const double tolerance,
+                        const long max_iter, const double t_max, double& toi) {
+                Eigen::Vector3d x[8];
+                gather(i, x);
+                double output_tolerance;
+                return kernels::query_status(
+                    kernel, method, t_max, toi, output_tolerance, x[0], x[1],
+                    x[2], x[3], x[4], x[5], x[6], x[7], min_distance...,
+                    tolerance, max_iter, err);
+            };
+        });
+        return query;
+    }
+
+    // Candidate of the adaptive refinement, which does not collide before
+    // lower_bound
+    struct Refinement {
+        double lower_bound;
+        int level;
+        size_t i;
+
+        // Earliest first, then coarsest first
+        bool operator>(const Refinement& other) const
+        {
+            return lower_bound > other.lower_bound
+                || (lower_bound == other.lower_bound && level > other.level);
+        }
+    };
+
+    // Earliest time of impact of the vertex-face then the edge-edge
+    // candidates, refining their tolerance adaptively.
+    double refine_earliest_toi(
+        const CCDMethod method,
+        const bool is_minimum_separation,
+        const size_t num_vf_queries,
+        const size_t num_ee_queries,
+        const std::function<RefinedQuery()>& vf_query,
+        const std::function<RefinedQuery()>& ee_query,
+        const RefinementPolicy& policy,
+        const double tolerance,
+        const long max_iter)
+    {
+        const size_t num_queries = num_vf_queries + num_ee_queries;
+        if (num_queries == 0) {
+            return std::numeric_limits<double>::infinity();
+        }
+        const CCDStatus status =
+            kernels::method_status(method, is_minimum_separation);
+        if (status != CCDStatus::OK) {
+            // Conservative answer upon failure.
+            kernels::report_failure(
+                num_vf_queries > 0 ? "Vertex-face" : "Edge-edge", method,
+                status);
+            return 0;
+        }
+        const RefinedQuery queries[2] = { vf_query(), ee_query() };
+
+        const int num_levels = method == CCDMethod::TIGHT_INCLUSION
+            ? std::max(policy.num_levels(tolerance), 1)
+            : 1;
+
+        std::vector<Refinement> coarse(num_queries);
+        for (size_t i = 0; i < num_queries; i++) {
+            coarse[i] = { 0.0, 0, i };
+        }
+        std::priority_queue<
+            Refinement, std::vector<Refinement>, std::greater<Refinement>>
+            refinements(std::greater<Refinement>(), std::move(coarse));
+
+        double earliest = std::numeric_limits<double>::infinity();
+        while (!refinements.empty()
+               && refinements.top().lower_bound < earliest) {
+            const Refinement r = refinements.top();
+            refinements.pop();
+
+            const bool is_last = r.level + 1 == num_levels;
+            const double level_tolerance = is_last
+                ? tolerance
+                : policy.level_tolerance(r.level, tolerance);
+            const long level_max_iter =
+                is_last ? max_iter : policy.level_max_iter(r.level, max_iter);
+
+            const bool is_vf = r.i < num_vf_queries;
+            double toi;
+            const CCDStatus query = queries[is_vf ? 0 : 1](
+                is_vf ? r.i : r.i - num_vf_queries, level_tolerance,
+                level_max_iter, std::min(earliest, 1.0), toi);
+            if (kernels::is_failure(query)) {
+                // Conservative answer upon failure.
+                kernels::report_failure(
+                    is_vf ? "Vertex-face" : "Edge-edge", method, query);
+                return 0;
+            }
+            if (query != CCDStatus::HIT) {
+                continue;
+            }
+            if (!is_time_of_impact_computed(method)) {
+                return 0; // Conservative
+            }
+            if (is_last) {
+                earliest = std::min(earliest, toi);
+            } else {
+                refinements.push({ toi, r.level + 1, r.i });
+            }
+        }
+        return earliest;
+    }
+
+    // Volume of the intersection of the swept bounding boxes of the two
+    // primitives of a query, whose first primitive has num_first_points points.
+    double swept_box_overlap(
+        const Eigen::Vector3d x[8], const int num_first_points)
+    {
+        Eigen::Array3d box_min[2], box_max[2];
+        for (int p = 0; p < 2; p++) {
+            box_min[p].setConstant(std::numeric_limits<double>::infinity());
+            box_max[p].setConstant(-std::numeric_limits<double>::infinity());
+        }
+        for (int j = 0; j < 8; j++) {
+            const int p = j % 4 < num_first_points ? 0 : 1;
+            box_min[p] = box_min[p].min(x[j].array());
+            box_max[p] = box_max[p].max(x[j].array());
+        }
+        return (box_max[0].min(box_max[1]) - box_min[0].max(box_min[1]))
+            .max(0.0)
+            .prod();
+    }
+
+    // Indices of the queries of a gather by decreasing overlap of their swept
+    // bounding boxes
+    template <typename Gather>
+    std::vector<size_t> overlap_order(
+        const Gather& gather,
+        const size_t num_queries,
+        const int num_first_points)
+    {
+        std::vector<double> overlaps(num_queries);
+        Eigen::Vector3d x[8];
+        for (size_t i = 0; i < num_queries; i++) {
+            gather(i, x);
+            overlaps[i] = swept_box_overlap(x, num_first_points);
+        }
+        std::vector<size_t> order(num_queries);
+        for (size_t i = 0; i < num_queries; i++) {
+            order[i] = i;
+        }
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+            return overlaps[a] > overlaps[b];
+        });
+        return order;
+    }
+
+    // Set found if some query of a gather collides, stopping all the threads
+    // as soon as one is found.
+    template <
+        template <CCDMethod> class Kernel,
+        typename Gather,
+        typename... Params>
+    void find_any_hit(
+        Executor* executor,
+        const char* query_type,
+        const size_t num_queries,
+        const CCDMethod method,
+        const Gather& gather,
+        const AnyHitOrder order,
+        std::atomic<bool>& found,
+        const Params&... params)
+    {
+        if (num_queries == 0 || found.load()) {
+            return;
+        }
+        std::vector<size_t> ordering;
+        if (order == AnyHitOrder::SWEPT_BOX_OVERLAP) {
+            ordering = overlap_order(
+                gather, num_queries, kernels::num_first_points<Kernel>::value);
+        }
+
+        const auto run = [&](const size_t begin, const size_t end) {
+            kernels::AnyHit any { found };
+            if (ordering.empty()) {
+                kernels::run_batch<Kernel>(
+                    query_type, end - begin, method,
+                    [&](const size_t i, Eigen::Vector3d x[8]) {
+                        gather(begin + i, x);
+                    },
+                    &any, params...);
+            } else {
+                kernels::run_batch<Kernel>(
+                    query_type, end - begin, method,
+                    [&](const size_t i, Eigen::Vector3d x[8]) {
+                        gather(ordering[begin + i], x);
+                    },
+                    &any, params...);
+            }
+        };
+        if (executor != nullptr) {
+            executor->parallel_for(num_queries, run);
+        } else {
+            run(0, num_queries);
+        }
+    }
+
+    // Whether some vertex-face or edge-edge candidate of a mesh collides
+    template <
+        template <CCDMethod> class VertexFaceKernel,
+        template <CCDMethod> class EdgeEdgeKernel,
+        typename... Params>
+    bool mesh_any_hit(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const std::vector<VertexFaceCandidate>& vf_candidates,
+        const std::vector<EdgeEdgeCandidate>& ee_candidates,
+        const CCDMethod method,
+        const AnyHitOrder order,
+        const Params&... params)
+    {
+        std::atomic<bool> found(false);
+        find_any_hit<VertexFaceKernel>(
+            executor, "Vertex-face", vf_candidates.size(), method,
+            VertexFaceGather { V0, V1, F, vf_candidates.data() }, order, found,
+            params...);
+        find_any_hit<EdgeEdgeKernel>(
+            executor, "Edge-edge", ee_candidates.size(), method,
+            EdgeEdgeGather { V0, V1, E, ee_candidates.data() }, order, found,
+            params...);
+        return found.load();
+    }
+
+} // namespace
+
+void meshVertexFaceCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const VertexFaceGather gather { V0, V1, F, candidates.data() };
+    kernels::run_batch<kernels::VertexFaceCCD>(
+        "Vertex-face", candidates.size(), method, gather, hits, tolerance,
+        max_iter, err);
+}
+
+void meshVertexFaceCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const VertexFaceGather gather { V0, V1, F, candidates.data() };
+    kernels::run_batch<kernels::VertexFaceCCD>(
+        "Vertex-face", candidates.size(), method, gather, results, tolerance,
+        max_iter, err);
+}
+
+void meshVertexFaceCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const VertexFaceGather gather {
+                V0, V1, F, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::VertexFaceCCD>(
+                "Vertex-face", end - begin, method, gather, hits + begin,
+                tolerance, max_iter, err);
+        });
+}
+
+void meshVertexFaceCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const VertexFaceGather gather {
+                V0, V1, F, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::VertexFaceCCD>(
+                "Vertex-face", end - begin, method, gather, results + begin,
+                tolerance, max_iter, err);
+        });
+}
+
+void meshEdgeEdgeCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const EdgeEdgeGather gather { V0, V1, E, candidates.data() };
+    kernels::run_batch<kernels::EdgeEdgeCCD>(
+        "Edge-edge", candidates.size(), method, gather, hits, tolerance,
+        max_iter, err);
+}
+
+void meshEdgeEdgeCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const EdgeEdgeGather gather { V0, V1, E, candidates.data() };
+    kernels::run_batch<kernels::EdgeEdgeCCD>(
+        "Edge-edge", candidates.size(), method, gather, results, tolerance,
+        max_iter, err);
+}
+
+void meshEdgeEdgeCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const EdgeEdgeGather gather {
+                V0, V1, E, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::EdgeEdgeCCD>(
+                "Edge-edge", end - begin, method, gather, hits + begin,
+                tolerance, max_iter, err);
+        });
+}
+
+void meshEdgeEdgeCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const EdgeEdgeGather gather {
+                V0, V1, E, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::EdgeEdgeCCD>(
+                "Edge-edge", end - begin, method, gather, results + begin,
+                tolerance, max_iter, err);
+        });
+}
+
+void meshVertexFaceMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const VertexFaceGather gather { V0, V1, F, candidates.data() };
+    kernels::run_batch<kernels::VertexFaceMSCCD>(
+        "Vertex-face", candidates.size(), method, gather, hits, min_distance,
+        tolerance, max_iter, err);
+}
+
+void meshVertexFaceMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const VertexFaceGather gather { V0, V1, F, candidates.data() };
+    kernels::run_batch<kernels::VertexFaceMSCCD>(
+        "Vertex-face", candidates.size(), method, gather, results, min_distance,
+        tolerance, max_iter, err);
+}
+
+void meshVertexFaceMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const VertexFaceGather gather {
+                V0, V1, F, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::VertexFaceMSCCD>(
+                "Vertex-face", end - begin, method, gather, hits + begin,
+                min_distance, tolerance, max_iter, err);
+        });
+}
+
+void meshVertexFaceMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const VertexFaceGather gather {
+                V0, V1, F, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::VertexFaceMSCCD>(
+                "Vertex-face", end - begin, method, gather, results + begin,
+                min_distance, tolerance, max_iter, err);
+        });
+}
+
+void meshEdgeEdgeMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const EdgeEdgeGather gather { V0, V1, E, candidates.data() };
+    kernels::run_batch<kernels::EdgeEdgeMSCCD>(
+        "Edge-edge", candidates.size(), method, gather, hits, min_distance,
+        tolerance, max_iter, err);
+}
+
+void meshEdgeEdgeMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const EdgeEdgeGather gather { V0, V1, E, candidates.data() };
+    kernels::run_batch<kernels::EdgeEdgeMSCCD>(
+        "Edge-edge", candidates.size(), method, gather, results, min_distance,
+        tolerance, max_iter, err);
+}
+
+void meshEdgeEdgeMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const EdgeEdgeGather gather {
+                V0, V1, E, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::EdgeEdgeMSCCD>(
+                "Edge-edge", end - begin, method, gather, hits + begin,
+                min_distance, tolerance, max_iter, err);
+        });
+}
+
+void meshEdgeEdgeMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    executor.parallel_for(
+        candidates.size(), [&](const size_t begin, const size_t end) {
+            const EdgeEdgeGather gather {
+                V0, V1, E, candidates.data() + begin
+            };
+            kernels::run_batch<kernels::EdgeEdgeMSCCD>(
+                "Edge-edge", end - begin, method, gather, results + begin,
+                min_distance, tolerance, max_iter, err);
+        });
+}
+
+double meshEarliestTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const VertexFaceGather vf_gather { V0, V1, F, vf_candidates.data() };
+    const EdgeEdgeGather ee_gather { V0, V1, E, ee_candidates.data() };
+    double earliest = std::numeric_limits<double>::infinity();
+    reduce_earliest_toi<kernels::VertexFaceCCD>(
+        "Vertex-face", vf_candidates.size(), method, vf_gather, earliest,
+        tolerance, max_iter, err);
+    reduce_earliest_toi<kernels::EdgeEdgeCCD>(
+        "Edge-edge", ee_candidates.size(), method, ee_gather, earliest,
+        tolerance, max_iter, err);
+    return earliest;
+}
+
+double meshEarliestMSTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    const VertexFaceGather vf_gather { V0, V1, F, vf_candidates.data() };
+    const EdgeEdgeGather ee_gather { V0, V1, E, ee_candidates.data() };
+    double earliest = std::numeric_limits<double>::infinity();
+    reduce_earliest_toi<kernels::VertexFaceMSCCD>(
+        "Vertex-face", vf_candidates.size(), method, vf_gather, earliest,
+        min_distance, tolerance, max_iter, err);
+    reduce_earliest_toi<kernels::EdgeEdgeMSCCD>(
+        "Edge-edge", ee_candidates.size(), method, ee_gather, earliest,
+        min_distance, tolerance, max_iter, err);
+    return earliest;
+}
+
+double meshEarliestTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const ErrorBounds& err)
+{
+    const VertexFaceGather vf_gather { V0, V1, F, vf_candidates.data() };
+    const EdgeEdgeGather ee_gather { V0, V1, E, ee_candidates.data() };
+    double earliest = std::numeric_limits<double>::infinity();
+    reduce_earliest_toi<kernels::VertexFaceCCD>(
+        "Vertex-face", vf_candidates.size(), method, vf_gather, earliest,
+        tolerance, max_iter, err.vertex_face);
+    reduce_earliest_toi<kernels::EdgeEdgeCCD>(
+        "Edge-edge", ee_candidates.size(), method, ee_gather, earliest,
+        tolerance, max_iter, err.edge_edge);
+    return earliest;
+}
+
+double meshEarliestMSTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const ErrorBounds& err)
+{
+    const VertexFaceGather vf_gather { V0, V1, F, vf_candidates.data() };
+    const EdgeEdgeGather ee_gather { V0, V1, E, ee_candidates.data() };
+    double earliest = std::numeric_limits<double>::infinity();
+    reduce_earliest_toi<kernels::VertexFaceMSCCD>(
+        "Vertex-face", vf_candidates.size(), method, vf_gather, earliest,
+        min_distance, tolerance, max_iter, err.vertex_face);
+    reduce_earliest_toi<kernels::EdgeEdgeMSCCD>(
+        "Edge-edge", ee_candidates.size(), method, ee_gather, earliest,
+        min_distance, tolerance, max_iter, err.edge_edge);
+    return earliest;
+}
+
+double meshEarliestTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const RefinementPolicy& policy,
+    const double tolerance,
+    const long max_iter,
+    const ErrorBounds& err)
+{
+    const VertexFaceGather vf_gather { V0, V1, F, vf_candidates.data() };
+    const EdgeEdgeGather ee_gather { V0, V1, E, ee_candidates.data() };
+    return refine_earliest_toi(
+        method, /*is_minimum_separation=*/false, vf_candidates.size(),
+        ee_candidates.size(),
+        [&] {
+            return refined_query<kernels::VertexFaceCCD>(
+                method, vf_gather, err.vertex_face);
+        },
+        [&] {
+            return refined_query<kernels::EdgeEdgeCCD>(
+                method, ee_gather, err.edge_edge);
+        },
+        policy, tolerance, max_iter);
+}
+
+double meshEarliestMSTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const RefinementPolicy& policy,
+    const double tolerance,
+    const long max_iter,
+    const ErrorBounds& err)
+{
+    const VertexFaceGather vf_gather { V0, V1, F, vf_candidates.data() };
+    const EdgeEdgeGather ee_gather { V0, V1, E, ee_candidates.data() };
+    return refine_earliest_toi(
+        method, /*is_minimum_separation=*/true, vf_candidates.size(),
+        ee_candidates.size(),
+        [&] {
+            return refined_query<kernels::VertexFaceMSCCD>(
+                method, vf_gather, err.vertex_face, min_distance);
+        },
+        [&] {
+            return refined_query<kernels::EdgeEdgeMSCCD>(
+                method, ee_gather, err.edge_edge, min_distance);
+        },
+        policy, tolerance, max_iter);
+}
+
+bool meshAnyHit(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const AnyHitOrder order,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    return mesh_any_hit<kernels::VertexFaceCCD, kernels::EdgeEdgeCCD>(
+        /*executor=*/nullptr, V0, V1, E, F, vf_candidates, ee_candidates,
+        method, order, tolerance, max_iter, err);
+}
+
+bool meshAnyHit(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const AnyHitOrder order,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    return mesh_any_hit<kernels::VertexFaceCCD, kernels::EdgeEdgeCCD>(
+        &executor, V0, V1, E, F, vf_candidates, ee_candidates, method, order,
+        tolerance, max_iter, err);
+}
+
+bool meshAnyMSHit(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const AnyHitOrder order,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    return mesh_any_hit<kernels::VertexFaceMSCCD, kernels::EdgeEdgeMSCCD>(
+        /*executor=*/nullptr, V0, V1, E, F, vf_candidates, ee_candidates,
+        method, order, min_distance, tolerance, max_iter, err);
+}
+
+bool meshAnyMSHit(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const AnyHitOrder order,
+    const double tolerance,
+    const long max_iter,
+    const Eigen::Array3d& err)
+{
+    return mesh_any_hit<kernels::VertexFaceMSCCD, kernels::EdgeEdgeMSCCD>(
+        &executor, V0, V1, E, F, vf_candidates, ee_candidates, method, order,
+        min_distance, tolerance, max_iter, err);
+}
+
+} // namespace ccd
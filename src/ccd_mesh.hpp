@@ -0,0 +1,601 @@
+/// @brief CCD of candidate pairs of primitives of a moving mesh
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd.hpp>
+#include <ccd_error_bounds.hpp>
+#include <ccd_executor.hpp>
+#include <ccd_refinement.hpp>
+
+namespace ccd {
+
+/// Candidate collision between a vertex and a face of a mesh.
+struct VertexFaceCandidate {
+    /// Row of the vertex in V0 and V1.
+    long vertex_id;
+    /// Row of the face in F.
+    long face_id;
+};
+
+/// Candidate collision between two edges of a mesh.
+struct EdgeEdgeCandidate {
+    /// Row of the first edge in E.
+    long edge0_id;
+    /// Row of the second edge in E.
+    long edge1_id;
+};
+
+/**
+ * @brief Detect collisions between candidate vertices and faces of a mesh.
+ *
+ * Equivalent to calling vertexFaceCCD on every candidate, but the positions
+ * are gathered from the mesh internally and the method is dispatched once.
+ * Candidates are culled with their swept bounding boxes like in the batched
+ * functions.
+ *
+ * @param[in]  V0          #V × 3 vertex positions at the start of the step.
+ * @param[in]  V1          #V × 3 vertex positions at the end of the step.
+ * @param[in]  F           #F × 3 vertex indices of the faces.
+ * @param[in]  candidates  Vertex-face pairs to check. Indices must be valid.
+ * @param[in]  method      Method of exact CCD.
+ * @param[out] hits        Array of candidates.size() results. hits[i] is true
+ *                         if the i-th candidate collides.
+ */
+void meshVertexFaceCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each candidate.
+ *
+ * @param[out] results  Array of candidates.size() results of vertexFaceCCD.
+ */
+void meshVertexFaceCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the candidates are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the candidates.
+ */
+void meshVertexFaceCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the candidates.
+ */
+void meshVertexFaceCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect collisions between candidate pairs of edges of a mesh.
+ *
+ * Equivalent to calling edgeEdgeCCD on every candidate, but the positions
+ * are gathered from the mesh internally and the method is dispatched once.
+ * Candidates are culled with their swept bounding boxes like in the batched
+ * functions.
+ *
+ * @param[in]  V0          #V × 3 vertex positions at the start of the step.
+ * @param[in]  V1          #V × 3 vertex positions at the end of the step.
+ * @param[in]  E           #E × 2 vertex indices of the edges.
+ * @param[in]  candidates  Edge-edge pairs to check. Indices must be valid.
+ * @param[in]  method      Method of exact CCD.
+ * @param[out] hits        Array of candidates.size() results. hits[i] is true
+ *                         if the i-th candidate collides.
+ */
+void meshEdgeEdgeCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each candidate.
+ *
+ * @param[out] results  Array of candidates.size() results of edgeEdgeCCD.
+ */
+void meshEdgeEdgeCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the candidates are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the candidates.
+ */
+void meshEdgeEdgeCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the candidates.
+ */
+void meshEdgeEdgeCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect proximity collisions between candidate vertices and faces of a
+ *        mesh.
+ *
+ * Mesh version of vertexFaceMSCCD. See meshVertexFaceCCD for the inputs.
+ *
+ * @param[in]  min_distance  Minimum separation distance.
+ * @param[in]  method        Method of minimum separation CCD.
+ * @param[out] hits          Array of candidates.size() results.
+ */
+void meshVertexFaceMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each candidate.
+ *
+ * @param[out] results  Array of candidates.size() results of vertexFaceMSCCD.
+ */
+void meshVertexFaceMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the candidates are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the candidates.
+ */
+void meshVertexFaceMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the candidates.
+ */
+void meshVertexFaceMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect proximity collisions between candidate pairs of edges of a
+ *        mesh.
+ *
+ * Mesh version of edgeEdgeMSCCD. See meshEdgeEdgeCCD for the inputs.
+ *
+ * @param[in]  min_distance  Minimum separation distance.
+ * @param[in]  method        Method of minimum separation CCD.
+ * @param[out] hits          Array of candidates.size() results.
+ */
+void meshEdgeEdgeMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each candidate.
+ *
+ * @param[out] results  Array of candidates.size() results of edgeEdgeMSCCD.
+ */
+void meshEdgeEdgeMSCCD(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the candidates are split across the threads of an
+ *        executor.
+ *
+ * @param[in]  executor  Executor running the queries.
+ * @param[out] hits      Array of results in the order of the candidates.
+ */
+void meshEdgeEdgeMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    bool* hits,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but also returns the time of impact of each query.
+ *
+ * @param[out] results  Array of results in the order of the candidates.
+ */
+void meshEdgeEdgeMSCCD(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const std::vector<EdgeEdgeCandidate>& candidates,
+    const double min_distance,
+    const CCDMethod method,
+    CCDResult* results,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Compute the earliest time of impact over a set of candidates.
+ *
+ * Intended for step-size control, where only the minimum time of impact is
+ * needed. Once a collision at time t is found, the remaining candidates are
+ * only checked over [0, t], which lets Tight Inclusion terminate early on
+ * queries that cannot collide any sooner. The search stops as soon as a time
+ * of impact of zero is found.
+ *
+ * Methods that do not compute a time of impact (see
+ * is_time_of_impact_computed) report 0 for any collision. Failed queries are
+ * also answered with 0.
+ *
+ * @param[in] V0             #V × 3 vertex positions at the start of the step.
+ * @param[in] V1             #V × 3 vertex positions at the end of the step.
+ * @param[in] E              #E × 2 vertex indices of the edges.
+ * @param[in] F              #F × 3 vertex indices of the faces.
+ * @param[in] vf_candidates  Vertex-face pairs to check.
+ * @param[in] ee_candidates  Edge-edge pairs to check.
+ * @param[in] method         Method of exact CCD.
+ *
+ * @returns The earliest time of impact in [0, 1], or infinity if no candidate
+ *          collides.
+ */
+double meshEarliestTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but with separate error bounds for the vertex-face and
+ *        edge-edge candidates (e.g., computed once per frame with
+ *        meshErrorBounds).
+ *
+ * @param[in] err  Error bounds of the candidates.
+ */
+double meshEarliestTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const ErrorBounds& err);
+
+/**
+ * @brief Same as above, but refines the tolerance of Tight Inclusion
+ *        adaptively.
+ *
+ * Every candidate is first checked with the coarse tolerance of the policy.
+ * Candidates are then rerun with the tolerance of the next level in the
+ * order of their time of impact, which is a lower bound on their time of
+ * impact with a tighter tolerance, and only while it is before the earliest
+ * time of impact found with the tolerance of the query. The result is as
+ * conservative as the one of meshEarliestTOI.
+ *
+ * Methods other than CCDMethod::TIGHT_INCLUSION do not use a tolerance and
+ * check every candidate once.
+ *
+ * @param[in] policy  Schedule of tolerances (see ccd_refinement.hpp).
+ */
+double meshEarliestTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const RefinementPolicy& policy,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const ErrorBounds& err = { { -1, 0, 0 }, { -1, 0, 0 } });
+
+/**
+ * @brief Compute the earliest time of impact with a minimum separation over a
+ *        set of candidates.
+ *
+ * Minimum separation version of meshEarliestTOI.
+ *
+ * @param[in] min_distance  Minimum separation distance.
+ * @param[in] method        Method of minimum separation CCD.
+ *
+ * @returns The earliest time of impact in [0, 1], or infinity if no candidate
+ *          collides.
+ */
+double meshEarliestMSTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but with separate error bounds for the vertex-face and
+ *        edge-edge candidates (e.g., computed once per frame with
+ *        meshErrorBounds).
+ *
+ * @param[in] err  Error bounds of the candidates.
+ */
+double meshEarliestMSTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const double tolerance,
+    const long max_iter,
+    const ErrorBounds& err);
+
+/**
+ * @brief Same as above, but refines the tolerance of Tight Inclusion
+ *        adaptively (see meshEarliestTOI).
+ *
+ * @param[in] policy  Schedule of tolerances (see ccd_refinement.hpp).
+ */
+double meshEarliestMSTOI(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const RefinementPolicy& policy,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const ErrorBounds& err = { { -1, 0, 0 }, { -1, 0, 0 } });
+
+/// Order in which meshAnyHit checks the candidates.
+enum class AnyHitOrder {
+    /// Order of the candidates
+    INPUT,
+    /// Decreasing volume of the intersection of the swept bounding boxes of
+    /// the two primitives, so that likely collisions are found first
+    SWEPT_BOX_OVERLAP
+};
+
+/**
+ * @brief Detect whether any candidate pair of a mesh collides.
+ *
+ * Intended for feasibility checks (e.g., of the steps of a line search),
+ * where only the existence of a collision matters. The candidates are checked
+ * like in meshVertexFaceCCD and meshEdgeEdgeCCD, vertex-face candidates
+ * first, and the search stops at the first collision. Failed queries count
+ * as collisions.
+ *
+ * @param[in] V0             #V × 3 vertex positions at the start of the step.
+ * @param[in] V1             #V × 3 vertex positions at the end of the step.
+ * @param[in] E              #E × 2 vertex indices of the edges.
+ * @param[in] F              #F × 3 vertex indices of the faces.
+ * @param[in] vf_candidates  Vertex-face pairs to check.
+ * @param[in] ee_candidates  Edge-edge pairs to check.
+ * @param[in] method         Method of exact CCD.
+ * @param[in] order          Order in which the candidates are checked.
+ *
+ * @returns Whether some candidate collides.
+ */
+bool meshAnyHit(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const AnyHitOrder order = AnyHitOrder::INPUT,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the candidates are split across the threads of an
+ *        executor, which all stop once one of them finds a collision.
+ *
+ * @param[in] executor  Executor running the queries.
+ */
+bool meshAnyHit(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const CCDMethod method,
+    const AnyHitOrder order = AnyHitOrder::INPUT,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Detect whether any candidate pair of a mesh is closer than a minimum
+ *        separation distance.
+ *
+ * Minimum separation version of meshAnyHit.
+ *
+ * @param[in] min_distance  Minimum separation distance.
+ * @param[in] method        Method of minimum separation CCD.
+ *
+ * @returns Whether some candidate collides.
+ */
+bool meshAnyMSHit(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const AnyHitOrder order = AnyHitOrder::INPUT,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+/**
+ * @brief Same as above, but the candidates are split across the threads of an
+ *        executor, which all stop once one of them finds a collision.
+ *
+ * @param[in] executor  Executor running the queries.
+ */
+bool meshAnyMSHit(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const std::vector<VertexFaceCandidate>& vf_candidates,
+    const std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double min_distance,
+    const CCDMethod method,
+    const AnyHitOrder order = AnyHitOrder::INPUT,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 });
+
+} // namespace ccd
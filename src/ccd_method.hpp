@@ -0,0 +1,60 @@
+/// @brief Methods of continuous collision detection
+///
+/// Kept apart from ccd.hpp so that the headers of the kernels can name the
+/// methods without including ccd.hpp, which includes the kernels in the
+/// header-only build (CCD_WRAPPER_HEADER_ONLY).
+
+#pragma once
+
+namespace ccd {
+
+/// Methods of continuous collision detection.
+enum CCDMethod {
+    /// Etienne Vouga's CCD using a root finder in floating points
+    FLOATING_POINT_ROOT_FINDER = 0,
+    /// Floating-point root-finder minimum separation CCD of [Lu et al. 2018]
+    MIN_SEPARATION_ROOT_FINDER,
+    /// Root parity method of [Brochu et al. 2012]
+    ROOT_PARITY,
+    /// Teseo's reimplementation of [Brochu et al. 2012] using rationals
+    RATIONAL_ROOT_PARITY,
+    /// Root parity with and fixes
+    FLOATING_POINT_ROOT_PARITY,
+    /// Rational root parity with fixes
+    RATIONAL_FIXED_ROOT_PARITY,
+    /// Bernstein sign classification method of [Tang et al. 2014]
+    BSC,
+    /// TightCCD method of [Wang et al. 2015]
+    TIGHT_CCD,
+    // SafeCCD
+    SAFE_CCD,
+    /// Interval based CCD of [Redon et al. 2002]
+    UNIVARIATE_INTERVAL_ROOT_FINDER,
+    /// Interval based CCD of [Redon et al. 2002] solved using [Snyder 1992]
+    MULTIVARIATE_INTERVAL_ROOT_FINDER,
+    /// Custom inclusion based CCD of [Wang et al. 2020]
+    TIGHT_INCLUSION,
+    /// Tight Inclusion at a coarse then the query's tolerance, checking the
+    /// positives it cannot refine with rational root parity (ccd_cascade.hpp)
+    PRECISION_CASCADE,
+    /// WARNING: Not a method! Counts the number of methods.
+    NUM_CCD_METHODS
+};
+
+static const char* method_names[CCDMethod::NUM_CCD_METHODS] = {
+    "FloatingPointRootFinder",
+    "MinSeparationRootFinder",
+    "RootParity",
+    "RationalRootParity",
+    "FloatingPointRootParity",
+    "RationalFixedRootParity",
+    "BSC",
+    "TightCCD",
+    "SafeCCD",
+    "UnivariateIntervalRootFinder",
+    "MultivariateIntervalRootFinder",
+    "TightInclusion",
+    "PrecisionCascade",
+};
+
+} // namespace ccd
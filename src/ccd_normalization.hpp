@@ -0,0 +1,109 @@
+/// @brief Exact translation of CCD queries to a local origin
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include <Eigen/Core>
+
+#include <ccd_counters.hpp>
+#include <ccd_filters.hpp>
+
+namespace ccd {
+
+/// Number of queries the normalisation stage translated.
+struct NormalizationStats {
+    uint64_t num_queries = 0; ///< Queries run with normalisation enabled.
+    uint64_t num_shifted = 0; ///< Queries translated along some axis.
+};
+
+namespace kernels {
+
+    struct NormalizationTag;
+    using NormalizationCounters = Counters<NormalizationTag, 2>;
+
+    inline std::atomic<bool>& normalization_flag()
+    {
+        static std::atomic<bool> flag(false);
+        return flag;
+    }
+
+    /**
+     * @brief Translate the points of a query so that the first one is at the
+     *        origin.
+     *
+     * An axis is only shifted if the differences of all its coordinates with
+     * the coordinate of the first point are exact (e.g., by Sterbenz's lemma
+     * when they are within a factor two of each other), which TwoSum checks.
+     * The translated query is therefore exactly the same query in another
+     * frame, with the same collisions and times of impact, but with smaller
+     * coordinates when it is far from the origin.
+     *
+     * @param[in,out] x  Start then end points of the query.
+     *
+     * @returns True if some axis was shifted.
+     */
+    inline bool normalize_query(Eigen::Vector3d (&x)[8])
+    {
+        bool shifted = false;
+        for (int k = 0; k < 3; k++) {
+            const double origin = x[0][k];
+            bool exact = origin != 0;
+            for (int j = 0; j < 8 && exact; j++) {
+                exact = is_exact_difference(x[j][k], origin);
+            }
+            if (!exact) {
+                continue;
+            }
+            for (int j = 0; j < 8; j++) {
+                x[j][k] -= origin;
+            }
+            shifted = true;
+        }
+        return shifted;
+    }
+
+} // namespace kernels
+
+/**
+ * @brief Enable or disable the normalisation of the queries.
+ *
+ * Tight Inclusion computes its floating-point error bound (err = {-1, 0, 0})
+ * from the magnitude of the coordinates, so queries far from the origin are
+ * more conservative and take more iterations. When enabled, each query is
+ * translated exactly to a local origin before running the method (see
+ * kernels::normalize_query). The answers of exact methods do not change.
+ *
+ * Disabled by default.
+ *
+ * @param[in] enabled  Whether to normalise the queries.
+ */
+inline void setQueryNormalization(const bool enabled)
+{
+    kernels::normalization_flag().store(enabled);
+}
+
+/// Whether the queries are normalised.
+inline bool isQueryNormalizationEnabled()
+{
+    return kernels::normalization_flag().load();
+}
+
+/// Queries run and translated by the normalisation stage, summed over all
+/// threads since the last reset.
+inline NormalizationStats queryNormalizationStats()
+{
+    NormalizationStats stats;
+    stats.num_queries = kernels::NormalizationCounters::read(0);
+    stats.num_shifted = kernels::NormalizationCounters::read(1);
+    return stats;
+}
+
+/// Reset the statistics of the normalisation stage.
+inline void resetQueryNormalizationStats()
+{
+    kernels::NormalizationCounters::reset();
+}
+
+} // namespace ccd
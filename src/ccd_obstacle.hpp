@@ -0,0 +1,386 @@
+/// @brief Specialised kernels for queries against static obstacles
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include <Eigen/Core>
+
+#include <ccd_counters.hpp>
+#include <ccd_filters.hpp>
+
+namespace ccd {
+
+/// Number of queries against a static obstacle and how they were answered.
+struct StaticObstacleStats {
+    /// Queries with a static face (vertex-face) or a static edge (edge-edge).
+    uint64_t num_queries = 0;
+    uint64_t num_negatives = 0; ///< Queries proven collision free.
+    uint64_t num_positives = 0; ///< Queries proven to collide.
+
+    /// Fraction of the queries answered by the specialised kernels.
+    double decided_rate() const
+    {
+        return num_queries > 0
+            ? double(num_negatives + num_positives) / double(num_queries)
+            : 0.0;
+    }
+};
+
+namespace kernels {
+
+    struct StaticObstacleTag;
+    // Counts of the static-obstacle, negative, and positive queries.
+    using StaticObstacleCounters = Counters<StaticObstacleTag, 3>;
+
+    inline std::atomic<bool>& static_obstacle_flag()
+    {
+        static std::atomic<bool> flag(true);
+        return flag;
+    }
+
+    /// Value computed in floating point with a bound on its error.
+    struct Bounded {
+        double value = 0;
+        double error = 0;
+
+        /// Sign of the exact value, or zero if it is unknown.
+        int sign() const
+        {
+            return value > error ? 1 : (value < -error ? -1 : 0);
+        }
+    };
+
+    /// det(u, v, w) of differences of the input points.
+    inline Bounded bounded_det(
+        const Eigen::Vector3d& u,
+        const Eigen::Vector3d& v,
+        const Eigen::Vector3d& w)
+    {
+        Coefficient c;
+        c.add(u, v, w);
+        // See is_never_coplanar.
+        return { c.value,
+                 8 * std::numeric_limits<double>::epsilon() * c.permanent
+                     + std::numeric_limits<double>::min() };
+    }
+
+    /// Orientation of a, b, c projected along axis k.
+    inline Bounded orient2d(
+        const Eigen::Vector3d& a,
+        const Eigen::Vector3d& b,
+        const Eigen::Vector3d& c,
+        const int k)
+    {
+        const int i = (k + 1) % 3, j = (k + 2) % 3;
+        const double l = (b[i] - a[i]) * (c[j] - a[j]);
+        const double r = (b[j] - a[j]) * (c[i] - a[i]);
+        // [Shewchuk 1997] bounds the error by 3u + 16u^2 times |l| + |r|.
+        return { l - r,
+                 4 * std::numeric_limits<double>::epsilon()
+                         * (std::abs(l) + std::abs(r))
+                     + std::numeric_limits<double>::min() };
+    }
+
+    /// Sign of a function linear in t over [t0, t1], from its bounded values
+    /// at t = 0 and t = 1, or zero if it is unknown.
+    inline int linear_sign(
+        const Bounded& f0, const Bounded& f1, const double t0, const double t1)
+    {
+        const double eps = std::numeric_limits<double>::epsilon();
+        int signs[2];
+        for (int i = 0; i < 2; i++) {
+            const double t = i == 0 ? t0 : t1;
+            Bounded f;
+            f.value = (1 - t) * f0.value + t * f1.value;
+            f.error = ((1 - t) * f0.error + t * f1.error) * (1 + 4 * eps)
+                + 4 * eps
+                    * ((1 - t) * std::abs(f0.value) + t * std::abs(f1.value))
+                + std::numeric_limits<double>::min();
+            signs[i] = f.sign();
+        }
+        return signs[0] == signs[1] ? signs[0] : 0;
+    }
+
+    /// Answer of a specialised static-obstacle kernel.
+    struct ObstacleAnswer {
+        enum Kind {
+            NONE,     ///< Not a query against a static obstacle.
+            NO_HIT,   ///< Proven collision free.
+            HIT,      ///< Proven to collide in [toi_lower, toi_upper].
+            UNDECIDED ///< Collisions, if any, are in [toi_lower, toi_upper].
+        };
+        Kind kind = NONE;
+        double toi_lower = 0;
+        double toi_upper = 1;
+    };
+
+    /**
+     * @brief Vertex-face query against a static face.
+     *
+     * With the face fixed, the coplanarity function f(t) = det(x1 - p(t),
+     * x2 - p(t), x3 - p(t)) is linear in t. If f(0) and f(1) have the same
+     * sign the vertex never reaches the plane of the face. Otherwise its
+     * single root is bracketed from the error bounds of f(0) and f(1), and
+     * the orientations of the vertex relative to the edges of the face,
+     * projected along the dominant axis of its normal, are also linear in t.
+     * If they have constant signs over the bracket, they tell whether the
+     * vertex crosses the plane inside the face. All signs are certified, so
+     * the decided answers are exact.
+     *
+     * @param x  Start then end points of the query, with x[1..3] == x[5..7].
+     */
+    inline ObstacleAnswer
+    static_face_query(const Eigen::Vector3d* const (&x)[8])
+    {
+        const double eps = std::numeric_limits<double>::epsilon();
+        const Eigen::Vector3d &p0 = *x[0], &p1 = *x[4];
+        const Eigen::Vector3d &a = *x[1], &b = *x[2], &c = *x[3];
+
+        ObstacleAnswer answer;
+        const Bounded f0 = bounded_det(a - p0, b - p0, c - p0);
+        const Bounded f1 = bounded_det(a - p1, b - p1, c - p1);
+        const int s0 = f0.sign(), s1 = f1.sign();
+        if (s0 != 0 && s0 == s1) {
+            answer.kind = ObstacleAnswer::NO_HIT;
+            return answer;
+        }
+        answer.kind = ObstacleAnswer::UNDECIDED;
+        if (s0 == 0 || s1 == 0) {
+            return answer;
+        }
+
+        // Bracket the root of f. It increases with |f(0)| and decreases with
+        // |f(1)|.
+        const double a0 = std::abs(f0.value), a1 = std::abs(f1.value);
+        const double lower =
+            (a0 - f0.error) / ((a0 - f0.error) + (a1 + f1.error));
+        const double upper =
+            (a0 + f0.error) / ((a0 + f0.error) + (a1 - f1.error));
+        answer.toi_lower = std::max(0.0, lower * (1 - 4 * eps));
+        answer.toi_upper = std::min(1.0, upper * (1 + 4 * eps));
+
+        const Eigen::Vector3d n = (b - a).cross(c - a);
+        int k;
+        n.cwiseAbs().maxCoeff(&k);
+        const int orientation = orient2d(a, b, c, k).sign();
+        if (orientation == 0) {
+            return answer;
+        }
+
+        const Eigen::Vector3d* const face[3] = { &a, &b, &c };
+        bool inside = true;
+        for (int i = 0; i < 3; i++) {
+            const Eigen::Vector3d &e0 = *face[i], &e1 = *face[(i + 1) % 3];
+            const int side = linear_sign(
+                orient2d(e0, e1, p0, k), orient2d(e0, e1, p1, k),
+                answer.toi_lower, answer.toi_upper);
+            if (side == -orientation) {
+                answer.kind = ObstacleAnswer::NO_HIT;
+                return answer;
+            }
+            inside = inside && side == orientation;
+        }
+        if (inside) {
+            answer.kind = ObstacleAnswer::HIT;
+        }
+        return answer;
+    }
+
+    /**
+     * @brief Edge-edge query against a static second edge.
+     *
+     * With the second edge fixed, the coplanarity function is
+     * det(a1(t) - a0(t), b0 - a0(t), b1 - b0), which is quadratic rather
+     * than cubic in t. The query is collision free if its three Bernstein
+     * coefficients have the same certified sign. Other queries are left
+     * undecided.
+     *
+     * @param x  Start then end points of the query, with x[2..3] == x[6..7].
+     */
+    inline ObstacleAnswer
+    static_edge_query(const Eigen::Vector3d* const (&x)[8])
+    {
+        const Eigen::Vector3d u0 = *x[1] - *x[0], u1 = *x[5] - *x[4];
+        const Eigen::Vector3d v0 = *x[2] - *x[0], v1 = *x[6] - *x[4];
+        const Eigen::Vector3d c = *x[3] - *x[2];
+
+        // Coefficients scaled by the binomial coefficients, which does not
+        // change their signs.
+        Coefficient b[3];
+        b[0].add(u0, v0, c);
+        b[1].add(u0, v1, c);
+        b[1].add(u1, v0, c);
+        b[2].add(u1, v1, c);
+
+        bool all_positive = true, all_negative = true;
+        for (const Coefficient& coefficient : b) {
+            const double error = 16 * std::numeric_limits<double>::epsilon()
+                    * coefficient.permanent
+                + std::numeric_limits<double>::min();
+            all_positive = all_positive && coefficient.value > error;
+            all_negative = all_negative && coefficient.value < -error;
+        }
+        ObstacleAnswer answer;
+        answer.kind = all_positive || all_negative ? ObstacleAnswer::NO_HIT
+                                                   : ObstacleAnswer::UNDECIDED;
+        return answer;
+    }
+
+    /// Whether the i-th point of a query does not move.
+    inline bool
+    is_static_point(const Eigen::Vector3d* const (&x)[8], const int i)
+    {
+        return *x[i] == *x[i + 4];
+    }
+
+    /**
+     * @brief Run the specialised kernel of a query against a static obstacle.
+     *
+     * @param num_first_points  Number of points of the first primitive: 1 for
+     *                          vertex-face and 2 for edge-edge queries.
+     * @param x                 Start then end points of the query.
+     * @param count             Whether to count the query in the statistics.
+     *
+     * @returns The answer of the kernel, ObstacleAnswer::NONE if the query is
+     *          not against a static face or edge.
+     */
+    inline ObstacleAnswer static_obstacle_query(
+        const int num_first_points,
+        const Eigen::Vector3d* const (&x)[8],
+        const bool count = true)
+    {
+        ObstacleAnswer answer;
+        if (num_first_points == 1) {
+            if (is_static_point(x, 1) && is_static_point(x, 2)
+                && is_static_point(x, 3)) {
+                answer = static_face_query(x);
+            }
+        } else if (is_static_point(x, 2) && is_static_point(x, 3)) {
+            answer = static_edge_query(x);
+        } else if (is_static_point(x, 0) && is_static_point(x, 1)) {
+            // Swap the edges.
+            answer = static_edge_query(
+                { x[2], x[3], x[0], x[1], x[6], x[7], x[4], x[5] });
+        }
+        if (count && answer.kind != ObstacleAnswer::NONE) {
+            StaticObstacleCounters::increment(0);
+            if (answer.kind == ObstacleAnswer::NO_HIT) {
+                StaticObstacleCounters::increment(1);
+            } else if (answer.kind == ObstacleAnswer::HIT) {
+                StaticObstacleCounters::increment(2);
+            }
+        }
+        return answer;
+    }
+
+} // namespace kernels
+
+/**
+ * @brief Enable or disable the specialised kernels for static obstacles.
+ *
+ * When the face of a vertex-face query or one edge of an edge-edge query does
+ * not move, e.g., for contacts with static environment geometry, a
+ * specialised kernel first tries to answer the query with certified floating
+ * point tests (see kernels::static_face_query and kernels::static_edge_query).
+ * Its answers are exact, and the queries it cannot decide run the method.
+ *
+ * The kernels apply to all methods and are enabled by default, except for
+ * the plain functions of MIN_SEPARATION_ROOT_FINDER, which keep a default
+ * minimum separation the exact zero-distance answers do not honour.
+ *
+ * @param[in] enabled  Whether to run the kernels before the methods.
+ */
+inline void setStaticObstacleKernels(const bool enabled)
+{
+    kernels::static_obstacle_flag().store(enabled);
+}
+
+/// Whether the specialised kernels for static obstacles are enabled.
+inline bool areStaticObstacleKernelsEnabled()
+{
+    return kernels::static_obstacle_flag().load();
+}
+
+/**
+ * @brief Conservative vertex-face CCD against a static face.
+ *
+ * Runs only the specialised kernel, so it never calls a method. Queries the
+ * kernel cannot decide (e.g., a vertex moving in the plane of the face or
+ * crossing it at an edge) are answered as collisions.
+ *
+ * @param[in]  vertex_start  Vertex at t = 0.
+ * @param[in]  vertex_end    Vertex at t = 1.
+ * @param[in]  face_vertex0  First vertex of the face.
+ * @param[in]  face_vertex1  Second vertex of the face.
+ * @param[in]  face_vertex2  Third vertex of the face.
+ * @param[out] toi           Lower bound of the time of impact, infinity if
+ *                           there is no collision.
+ *
+ * @returns True if the vertex may collide with the face.
+ */
+inline bool vertexStaticFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0,
+    const Eigen::Vector3d& face_vertex1,
+    const Eigen::Vector3d& face_vertex2,
+    double& toi)
+{
+    const kernels::ObstacleAnswer answer = kernels::static_obstacle_query(
+        /*num_first_points=*/1,
+        { &vertex_start, &face_vertex0, &face_vertex1, &face_vertex2,
+          &vertex_end, &face_vertex0, &face_vertex1, &face_vertex2 });
+    const bool hit = answer.kind != kernels::ObstacleAnswer::NO_HIT;
+    toi = hit ? answer.toi_lower : std::numeric_limits<double>::infinity();
+    return hit;
+}
+
+/**
+ * @brief Conservative edge-edge CCD against a static edge.
+ *
+ * Same as vertexStaticFaceCCD for a moving first edge and a static second
+ * edge. The kernel only proves that edges do not collide, so the time of
+ * impact of a collision is zero.
+ */
+inline bool edgeStaticEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0,
+    const Eigen::Vector3d& edge1_vertex1,
+    double& toi)
+{
+    const kernels::ObstacleAnswer answer = kernels::static_obstacle_query(
+        /*num_first_points=*/2,
+        { &edge0_vertex0_start, &edge0_vertex1_start, &edge1_vertex0,
+          &edge1_vertex1, &edge0_vertex0_end, &edge0_vertex1_end,
+          &edge1_vertex0, &edge1_vertex1 });
+    const bool hit = answer.kind != kernels::ObstacleAnswer::NO_HIT;
+    toi = hit ? answer.toi_lower : std::numeric_limits<double>::infinity();
+    return hit;
+}
+
+/// Queries against static obstacles and the ones answered by the specialised
+/// kernels, summed over all threads since the last reset.
+inline StaticObstacleStats staticObstacleStats()
+{
+    StaticObstacleStats stats;
+    stats.num_queries = kernels::StaticObstacleCounters::read(0);
+    stats.num_negatives = kernels::StaticObstacleCounters::read(1);
+    stats.num_positives = kernels::StaticObstacleCounters::read(2);
+    return stats;
+}
+
+/// Reset the statistics of the specialised kernels for static obstacles.
+inline void resetStaticObstacleStats()
+{
+    kernels::StaticObstacleCounters::reset();
+}
+
+} // namespace ccd
@@ -0,0 +1,86 @@
+/// @brief Tolerance schedules of the adaptive earliest time of impact
+
+#pragma once
+
+namespace ccd {
+
+/**
+ * @brief Schedule of tolerances of the adaptive refinement of
+ *        meshEarliestTOI.
+ *
+ * Tight Inclusion decides most negative queries long before reaching a tight
+ * tolerance, and only the queries that may collide before the earliest time
+ * of impact need a tight one. The adaptive refinement first runs every
+ * candidate with the tolerance of level 0, then only reruns the candidates
+ * whose time of impact is before the current earliest one with the tolerance
+ * of the next level. The last level always uses the tolerance and iteration
+ * budget of the query.
+ */
+class RefinementPolicy {
+public:
+    virtual ~RefinementPolicy() = default;
+
+    /**
+     * @brief Number of levels of the schedule, including the last one.
+     *
+     * @param[in] tolerance  Tolerance of the query.
+     */
+    virtual int num_levels(const double tolerance) const = 0;
+
+    /**
+     * @brief Tolerance of a level before the last one.
+     *
+     * @param[in] level      Level in [0, num_levels(tolerance) - 1).
+     * @param[in] tolerance  Tolerance of the query.
+     */
+    virtual double
+    level_tolerance(const int level, const double tolerance) const = 0;
+
+    /**
+     * @brief Maximum number of iterations of a level before the last one.
+     *
+     * @param[in] level     Level in [0, num_levels(tolerance) - 1).
+     * @param[in] max_iter  Maximum number of iterations of the query.
+     */
+    virtual long
+    level_max_iter(const int /*level*/, const long max_iter) const
+    {
+        return max_iter;
+    }
+};
+
+/**
+ * @brief Schedule dividing the tolerance by a constant factor at each level,
+ *        from a coarse tolerance down to the tolerance of the query.
+ */
+class GeometricRefinementPolicy : public RefinementPolicy {
+public:
+    /// Tolerance of the first level
+    double coarse_tolerance = 1e-2;
+    /// Ratio of the tolerances of two consecutive levels, in (0, 1)
+    double factor = 1e-2;
+
+    int num_levels(const double tolerance) const override
+    {
+        // Skip the levels no coarser than the query up to the rounding of
+        // the products (e.g., 1e-2 * 1e-2 * 1e-2 > 1e-6).
+        int n = 1;
+        for (double t = coarse_tolerance;
+             t > tolerance * (1 + 1e-12) && factor < 1; t *= factor) {
+            n++;
+        }
+        return n;
+    }
+
+    double level_tolerance(
+        const int level, const double /*tolerance*/) const override
+    {
+        double t = coarse_tolerance;
+        for (int i = 0; i < level; i++) {
+            t *= factor;
+        }
+        return t;
+    }
+};
+
+} // namespace ccd
@@ -0,0 +1,181 @@
+// Assignment of the vertices and edges of a mesh to its triangles
+#include "ccd_representative_triangles.hpp"
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+#include <ccd_bvh.hpp>
+
+namespace ccd {
+
+namespace {
+
+    void face_face_candidates(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& F,
+        std::vector<FaceFaceCandidate>& ff_candidates,
+        const double inflation_radius)
+    {
+        std::vector<SweptBox> vertex_boxes, edge_boxes, face_boxes;
+        broad_phase::swept_boxes(
+            executor, V0, V1, Eigen::MatrixXi(0, 2), F, inflation_radius,
+            vertex_boxes, edge_boxes, face_boxes);
+        broad_phase::BoxTree tree;
+        tree.build(face_boxes);
+        broad_phase::gather_candidates(
+            executor, face_boxes.size(), ff_candidates,
+            [&](const size_t f0, std::vector<FaceFaceCandidate>& found) {
+                tree.query(face_boxes[f0], [&](const long f1) {
+                    if (f1 > long(f0)) {
+                        found.push_back({ long(f0), f1 });
+                    }
+                });
+            });
+    }
+
+} // namespace
+
+void faceFaceCandidates(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    std::vector<FaceFaceCandidate>& ff_candidates,
+    const double inflation_radius)
+{
+    face_face_candidates(
+        /*executor=*/nullptr, V0, V1, F, ff_candidates, inflation_radius);
+}
+
+void faceFaceCandidates(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    std::vector<FaceFaceCandidate>& ff_candidates,
+    const double inflation_radius)
+{
+    face_face_candidates(&executor, V0, V1, F, ff_candidates, inflation_radius);
+}
+
+RepresentativeTriangles::RepresentativeTriangles(
+    const Eigen::MatrixXi& E, const Eigen::MatrixXi& F)
+    : faces(F)
+    , adjacency(E, F)
+    , vertex_owners(F.size() > 0 ? F.maxCoeff() + 1 : 0, -1)
+    , edge_owners(E.rows(), -1)
+    , face_edges(F.rows())
+{
+    std::map<std::pair<int, int>, long> edge_ids;
+    for (long e = 0; e < E.rows(); e++) {
+        const int a = E(e, 0), b = E(e, 1);
+        edge_ids.emplace(std::make_pair(std::min(a, b), std::max(a, b)), e);
+    }
+
+    // Faces in increasing order, so that the first incident face owns a
+    // feature.
+    for (long f = 0; f < F.rows(); f++) {
+        for (int i = 0; i < 3; i++) {
+            long& vertex_owner = vertex_owners[F(f, i)];
+            if (vertex_owner < 0) {
+                vertex_owner = f;
+            }
+
+            const int a = F(f, i), b = F(f, (i + 1) % 3);
+            const auto edge =
+                edge_ids.find(std::make_pair(std::min(a, b), std::max(a, b)));
+            face_edges[f][i] = edge == edge_ids.end() ? -1 : edge->second;
+            if (face_edges[f][i] >= 0 && edge_owners[face_edges[f][i]] < 0) {
+                edge_owners[face_edges[f][i]] = f;
+            }
+        }
+    }
+}
+
+void RepresentativeTriangles::candidates(
+    const std::vector<FaceFaceCandidate>& ff_candidates,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(
+        /*executor=*/nullptr, ff_candidates, vf_candidates, ee_candidates);
+}
+
+void RepresentativeTriangles::candidates(
+    Executor& executor,
+    const std::vector<FaceFaceCandidate>& ff_candidates,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(&executor, ff_candidates, vf_candidates, ee_candidates);
+}
+
+void RepresentativeTriangles::candidates(
+    Executor* executor,
+    const std::vector<FaceFaceCandidate>& ff_candidates,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    const MeshAdjacency* culled = broad_phase::culling(adjacency);
+    // Without culling, the pairs of a face with itself follow the pairs of
+    // distinct faces.
+    const size_t num_pairs =
+        ff_candidates.size() + (culled == nullptr ? faces.rows() : 0);
+    const auto pair = [&](const size_t i) {
+        if (i < ff_candidates.size()) {
+            return ff_candidates[i];
+        }
+        const long f = long(i - ff_candidates.size());
+        return FaceFaceCandidate { f, f };
+    };
+
+    broad_phase::gather_candidates(
+        executor, num_pairs, vf_candidates,
+        [&](const size_t i, std::vector<VertexFaceCandidate>& found) {
+            // Vertices owned by a face against the other face
+            const auto add = [&](const long owner, const long f) {
+                for (int k = 0; k < 3; k++) {
+                    const long v = faces(owner, k);
+                    const VertexFaceCandidate candidate { v, f };
+                    if (vertex_owners[v] == owner
+                        && !broad_phase::is_culled(culled, candidate)) {
+                        found.push_back(candidate);
+                    }
+                }
+            };
+            const FaceFaceCandidate faces_pair = pair(i);
+            add(faces_pair.face0_id, faces_pair.face1_id);
+            if (faces_pair.face0_id != faces_pair.face1_id) {
+                add(faces_pair.face1_id, faces_pair.face0_id);
+            }
+        });
+
+    broad_phase::gather_candidates(
+        executor, num_pairs, ee_candidates,
+        [&](const size_t i, std::vector<EdgeEdgeCandidate>& found) {
+            const FaceFaceCandidate faces_pair = pair(i);
+            const long f0 = faces_pair.face0_id, f1 = faces_pair.face1_id;
+            for (int k0 = 0; k0 < 3; k0++) {
+                const long e0 = face_edges[f0][k0];
+                if (e0 < 0 || edge_owners[e0] != f0) {
+                    continue;
+                }
+                // The pairs of edges of a face with itself are unordered.
+                for (int k1 = f0 == f1 ? k0 + 1 : 0; k1 < 3; k1++) {
+                    const long e1 = face_edges[f1][k1];
+                    if (e1 < 0 || edge_owners[e1] != f1) {
+                        continue;
+                    }
+                    const EdgeEdgeCandidate candidate { std::min(e0, e1),
+                                                        std::max(e0, e1) };
+                    if (!broad_phase::is_culled(culled, candidate)) {
+                        found.push_back(candidate);
+                    }
+                }
+            }
+        });
+}
+
+} // namespace ccd
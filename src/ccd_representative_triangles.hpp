@@ -0,0 +1,126 @@
+/// @brief Assignment of the vertices and edges of a mesh to its triangles
+
+#pragma once
+
+#include <array>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_broad_phase.hpp>
+
+namespace ccd {
+
+/**
+ * @brief Find the pairs of faces of a moving mesh whose swept bounding boxes
+ *        intersect, with a hierarchy of the boxes of the faces.
+ *
+ * @param[in]  V0                #V × 3 vertex positions at the start.
+ * @param[in]  V1                #V × 3 vertex positions at the end.
+ * @param[in]  F                 #F × 3 vertex indices of the faces.
+ * @param[out] ff_candidates     Pairs of distinct faces whose boxes
+ *                               intersect, with face0_id < face1_id.
+ * @param[in]  inflation_radius  Distance by which the boxes are inflated
+ *                               (e.g., the minimum separation distance).
+ */
+void faceFaceCandidates(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    std::vector<FaceFaceCandidate>& ff_candidates,
+    const double inflation_radius = 0);
+
+/// Same as above, but the pairs are found by the threads of an executor.
+void faceFaceCandidates(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& F,
+    std::vector<FaceFaceCandidate>& ff_candidates,
+    const double inflation_radius = 0);
+
+/**
+ * @brief Representative triangles of a mesh: each vertex and edge of a face
+ *        is owned by exactly one of its incident faces.
+ *
+ * A pair of nearby faces contains 6 vertex-face and 9 edge-edge pairs, and
+ * the pairs of faces around a vertex or an edge all contain its pairs, so
+ * expanding every pair of faces repeats the same elementary pairs many
+ * times. Expanding a pair of faces into the pairs of the features each face
+ * owns instead, the vertices of one against the other face and the edges of
+ * one against the edges of the other, issues each elementary pair once (see
+ * Curtis et al., "Fast Collision Detection for Deformable Models using
+ * Representative-Triangles"). The boxes of the features are inside the box
+ * of their owner, so no pair whose boxes intersect is missed.
+ *
+ * A vertex or an edge is owned by its incident face of smallest index. The
+ * vertices and edges that are not on a face are not owned, and the edges of
+ * a face that are not in E are skipped.
+ */
+class RepresentativeTriangles {
+public:
+    RepresentativeTriangles() = default;
+
+    /**
+     * @param[in] E  #E × 2 vertex indices of the edges.
+     * @param[in] F  #F × 3 vertex indices of the faces.
+     */
+    RepresentativeTriangles(const Eigen::MatrixXi& E, const Eigen::MatrixXi& F);
+
+    /// Face owning a vertex, or -1 if the vertex is not on a face.
+    long vertex_owner(const long vertex_id) const
+    {
+        return vertex_id < long(vertex_owners.size())
+            ? vertex_owners[vertex_id]
+            : -1;
+    }
+
+    /// Face owning an edge, or -1 if the edge is not on a face.
+    long edge_owner(const long edge_id) const
+    {
+        return edge_owners[edge_id];
+    }
+
+    /**
+     * @brief Expand pairs of faces into the vertex-face and edge-edge pairs
+     *        of the features they own, each issued once.
+     *
+     * The pairs of adjacent primitives are skipped if the adjacency culling
+     * is enabled (see setAdjacencyCulling). Otherwise, each face is also
+     * paired with itself, which gives the adjacent pairs of its features.
+     *
+     * @param[in]  ff_candidates  Pairs of distinct faces (see
+     *                            faceFaceCandidates).
+     * @param[out] vf_candidates  Sorted vertex-face pairs.
+     * @param[out] ee_candidates  Sorted edge-edge pairs, with
+     *                            edge0_id < edge1_id.
+     */
+    void candidates(
+        const std::vector<FaceFaceCandidate>& ff_candidates,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /// Same as above, but the pairs are expanded by the threads of an
+    /// executor.
+    void candidates(
+        Executor& executor,
+        const std::vector<FaceFaceCandidate>& ff_candidates,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+private:
+    void candidates(
+        Executor* executor,
+        const std::vector<FaceFaceCandidate>& ff_candidates,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    Eigen::MatrixXi faces;
+    MeshAdjacency adjacency;
+    std::vector<long> vertex_owners;
+    std::vector<long> edge_owners;
+    /// Edges of each face, or -1 if not in E
+    std::vector<std::array<long, 3>> face_edges;
+};
+
+} // namespace ccd
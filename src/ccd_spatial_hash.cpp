@@ -0,0 +1,313 @@
+// Uniform spatial hash broad phase of a moving mesh
+#include "ccd_spatial_hash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+namespace ccd {
+
+namespace {
+
+    // Cells per axis. The coordinates of a cell are packed in 21 bits each.
+    const int64_t GRID_SIZE = int64_t(1) << 21;
+
+    // Largest mean number of cells overlapped by a box
+    const double MAX_CELLS_PER_BOX = 64;
+
+    // Uniform grid covering the swept boxes
+    struct Grid {
+        Eigen::Array3d origin;
+        double cell_size;
+
+        // Coordinate of the cell containing x along axis k, clamped to the
+        // grid
+        int64_t coordinate(const double x, const int k) const
+        {
+            const double c = std::floor((x - origin[k]) / cell_size);
+            return c > 0 ? std::min(int64_t(c), GRID_SIZE - 1) : 0;
+        }
+
+        // Key of the cell of coordinates (i, j, k)
+        static uint64_t key(const int64_t i, const int64_t j, const int64_t k)
+        {
+            return (uint64_t(i) << 42) | (uint64_t(j) << 21) | uint64_t(k);
+        }
+
+        // Number of cells overlapped by a box
+        double num_cells(const SweptBox& box) const
+        {
+            double n = 1;
+            for (int k = 0; k < 3; k++) {
+                n *= double(
+                    coordinate(box.max[k], k) - coordinate(box.min[k], k) + 1);
+            }
+            return n;
+        }
+
+        // Key of the cell containing a point
+        uint64_t key(const Eigen::Array3d& p) const
+        {
+            return key(coordinate(p[0], 0), coordinate(p[1], 1),
+                       coordinate(p[2], 2));
+        }
+    };
+
+    // Primitive overlapping a cell
+    struct CellEntry {
+        uint64_t cell;
+        long id;
+
+        bool operator<(const CellEntry& other) const
+        {
+            return cell < other.cell || (cell == other.cell && id < other.id);
+        }
+    };
+
+    // Largest extent of a box
+    double extent(const SweptBox& box)
+    {
+        return (box.max - box.min).maxCoeff();
+    }
+
+    Grid make_grid(
+        const std::vector<SweptBox>& vertex_boxes,
+        const std::vector<SweptBox>& edge_boxes,
+        const std::vector<SweptBox>& face_boxes,
+        double cell_size)
+    {
+        Grid grid;
+        grid.origin.setConstant(std::numeric_limits<double>::infinity());
+        Eigen::Array3d corner = -grid.origin;
+        for (const std::vector<SweptBox>* boxes :
+             { &vertex_boxes, &edge_boxes, &face_boxes }) {
+            for (const SweptBox& box : *boxes) {
+                grid.origin = grid.origin.min(box.min);
+                corner = corner.max(box.max);
+            }
+        }
+
+        if (!(cell_size > 0)) {
+            // Mean size of the edges, which also bounds the size of the faces
+            // of a manifold mesh.
+            const std::vector<SweptBox>& boxes =
+                edge_boxes.empty() ? vertex_boxes : edge_boxes;
+            double sum = 0;
+            for (const SweptBox& box : boxes) {
+                sum += extent(box);
+            }
+            cell_size = boxes.empty() ? 0 : sum / boxes.size();
+        }
+        // The grid must fit in GRID_SIZE cells per axis.
+        const double size = (corner - grid.origin).maxCoeff();
+        grid.cell_size = std::max(cell_size, size / (GRID_SIZE - 1));
+        if (!(grid.cell_size > 0) || !std::isfinite(grid.cell_size)) {
+            grid.cell_size = 1;
+        }
+
+        // Coarsen the grid if the boxes overlap too many cells, which would
+        // exhaust the memory with cells much smaller than the boxes.
+        const size_t num_boxes =
+            vertex_boxes.size() + edge_boxes.size() + face_boxes.size();
+        while (true) {
+            double num_cells = 0;
+            for (const std::vector<SweptBox>* boxes :
+                 { &vertex_boxes, &edge_boxes, &face_boxes }) {
+                for (const SweptBox& box : *boxes) {
+                    num_cells += grid.num_cells(box);
+                }
+            }
+            if (num_cells <= MAX_CELLS_PER_BOX * num_boxes) {
+                break;
+            }
+            grid.cell_size *= 2;
+        }
+        return grid;
+    }
+
+    // Entries of the cells overlapped by the boxes, sorted by cell
+    std::vector<CellEntry> hash_boxes(
+        Executor* executor,
+        const Grid& grid,
+        const std::vector<SweptBox>& boxes)
+    {
+        const auto range = [&](const SweptBox& box, int k) {
+            return std::make_pair(
+                grid.coordinate(box.min[k], k), grid.coordinate(box.max[k], k));
+        };
+
+        // Offsets of the entries of each box
+        std::vector<size_t> offsets(boxes.size() + 1, 0);
+        broad_phase::parallel_for(
+            executor, boxes.size(), [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    offsets[i + 1] = size_t(grid.num_cells(boxes[i]));
+                }
+            });
+        for (size_t i = 0; i < boxes.size(); i++) {
+            offsets[i + 1] += offsets[i];
+        }
+
+        std::vector<CellEntry> entries(offsets.back());
+        broad_phase::parallel_for(
+            executor, boxes.size(), [&](const size_t begin, const size_t end) {
+                for (size_t i = begin; i < end; i++) {
+                    const auto x = range(boxes[i], 0), y = range(boxes[i], 1),
+                               z = range(boxes[i], 2);
+                    size_t offset = offsets[i];
+                    for (int64_t a = x.first; a <= x.second; a++) {
+                        for (int64_t b = y.first; b <= y.second; b++) {
+                            for (int64_t c = z.first; c <= z.second; c++) {
+                                entries[offset++] = { Grid::key(a, b, c),
+                                                      long(i) };
+                            }
+                        }
+                    }
+                }
+            });
+        std::sort(entries.begin(), entries.end());
+        return entries;
+    }
+
+    // Start of each run of entries of the same cell, followed by the number
+    // of entries
+    std::vector<size_t> cell_starts(const std::vector<CellEntry>& entries)
+    {
+        std::vector<size_t> starts;
+        for (size_t i = 0; i < entries.size(); i++) {
+            if (i == 0 || entries[i].cell != entries[i - 1].cell) {
+                starts.push_back(i);
+            }
+        }
+        starts.push_back(entries.size());
+        return starts;
+    }
+
+    // Run find(cell, begin, end, found) over the runs of entries of the same
+    // cell, in parallel if there is an executor.
+    template <typename Candidate, typename Find>
+    void find_candidates(
+        Executor* executor,
+        const std::vector<CellEntry>& entries,
+        std::vector<Candidate>& candidates,
+        Find&& find)
+    {
+        const std::vector<size_t> starts = cell_starts(entries);
+        broad_phase::gather_candidates(
+            executor, starts.size() - 1, candidates,
+            [&](const size_t i, std::vector<Candidate>& found) {
+                find(entries[starts[i]].cell, starts[i], starts[i + 1], found);
+            });
+    }
+
+    void spatial_hash_candidates(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates,
+        const double inflation_radius,
+        const double cell_size)
+    {
+        std::vector<SweptBox> vertex_boxes, edge_boxes, face_boxes;
+        broad_phase::swept_boxes(
+            executor, V0, V1, E, F, inflation_radius, vertex_boxes, edge_boxes,
+            face_boxes);
+        const Grid grid =
+            make_grid(vertex_boxes, edge_boxes, face_boxes, cell_size);
+        MeshAdjacency adjacency;
+        if (isAdjacencyCullingEnabled()) {
+            adjacency = MeshAdjacency(E, F);
+        }
+        const MeshAdjacency* culled = broad_phase::culling(adjacency);
+
+        // Whether the cell reports the pair of boxes
+        const auto is_reported = [&](const uint64_t cell, const SweptBox& a,
+                                     const SweptBox& b) {
+            return a.intersects(b) && grid.key(a.min.max(b.min)) == cell;
+        };
+
+        const std::vector<CellEntry> vertex_entries =
+            hash_boxes(executor, grid, vertex_boxes);
+        const std::vector<CellEntry> face_entries =
+            hash_boxes(executor, grid, face_boxes);
+        find_candidates(
+            executor, vertex_entries, vf_candidates,
+            [&](const uint64_t cell, const size_t begin, const size_t end,
+                std::vector<VertexFaceCandidate>& found) {
+                const auto faces = std::equal_range(
+                    face_entries.begin(), face_entries.end(),
+                    CellEntry { cell, 0 },
+                    [](const CellEntry& a, const CellEntry& b) {
+                        return a.cell < b.cell;
+                    });
+                for (size_t i = begin; i < end; i++) {
+                    const long v = vertex_entries[i].id;
+                    for (auto f = faces.first; f != faces.second; f++) {
+                        const VertexFaceCandidate candidate { v, f->id };
+                        if (is_reported(
+                                cell, vertex_boxes[v], face_boxes[f->id])
+                            && !broad_phase::is_culled(culled, candidate)) {
+                            found.push_back(candidate);
+                        }
+                    }
+                }
+            });
+
+        const std::vector<CellEntry> edge_entries =
+            hash_boxes(executor, grid, edge_boxes);
+        find_candidates(
+            executor, edge_entries, ee_candidates,
+            [&](const uint64_t cell, const size_t begin, const size_t end,
+                std::vector<EdgeEdgeCandidate>& found) {
+                for (size_t i = begin; i < end; i++) {
+                    const long e0 = edge_entries[i].id;
+                    for (size_t j = i + 1; j < end; j++) {
+                        const long e1 = edge_entries[j].id;
+                        const EdgeEdgeCandidate candidate { e0, e1 };
+                        if (is_reported(cell, edge_boxes[e0], edge_boxes[e1])
+                            && !broad_phase::is_culled(culled, candidate)) {
+                            found.push_back(candidate);
+                        }
+                    }
+                }
+            });
+    }
+
+} // namespace
+
+void spatialHashCandidates(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double inflation_radius,
+    const double cell_size)
+{
+    spatial_hash_candidates(
+        /*executor=*/nullptr, V0, V1, E, F, vf_candidates, ee_candidates,
+        inflation_radius, cell_size);
+}
+
+void spatialHashCandidates(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double inflation_radius,
+    const double cell_size)
+{
+    spatial_hash_candidates(
+        &executor, V0, V1, E, F, vf_candidates, ee_candidates,
+        inflation_radius, cell_size);
+}
+
+} // namespace ccd
@@ -0,0 +1,65 @@
+/// @brief Uniform spatial hash broad phase of a moving mesh
+
+#pragma once
+
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_broad_phase.hpp>
+
+namespace ccd {
+
+/**
+ * @brief Find the candidate pairs of primitives of a moving mesh with a
+ *        uniform spatial hash of their swept bounding boxes.
+ *
+ * Each swept box (see sweptBoxes) is inserted in the cells of a uniform grid
+ * it overlaps, and the pairs of primitives sharing a cell whose boxes
+ * intersect are candidates. A pair is only reported by the cell containing
+ * the minimum corner of the intersection of its boxes, so it is reported
+ * once. The candidates are sorted and can be passed to the mesh functions
+ * (e.g., meshVertexFaceCCD) or gathered for the scalar ones. The pairs of
+ * adjacent primitives are skipped if the adjacency culling is enabled (see
+ * setAdjacencyCulling).
+ *
+ * @param[in]  V0                #V × 3 vertex positions at the start.
+ * @param[in]  V1                #V × 3 vertex positions at the end.
+ * @param[in]  E                 #E × 2 vertex indices of the edges.
+ * @param[in]  F                 #F × 3 vertex indices of the faces.
+ * @param[out] vf_candidates     Vertex-face pairs whose boxes intersect.
+ * @param[out] ee_candidates     Pairs of distinct edges whose boxes
+ *                               intersect, with edge0_id < edge1_id.
+ * @param[in]  inflation_radius  Distance by which the boxes are inflated
+ *                               (e.g., the minimum separation distance).
+ * @param[in]  cell_size         Side length of the cells. Zero uses the mean
+ *                               size of the swept boxes of the edges.
+ */
+void spatialHashCandidates(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double inflation_radius = 0,
+    const double cell_size = 0);
+
+/**
+ * @brief Same as above, but the hash is built and queried by the threads of
+ *        an executor.
+ *
+ * @param[in] executor  Executor running the broad phase.
+ */
+void spatialHashCandidates(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates,
+    const double inflation_radius = 0,
+    const double cell_size = 0);
+
+} // namespace ccd
@@ -0,0 +1,542 @@
+/// @brief CCD functions with the method fixed at compile time
+///
+/// A solver typically uses a single method, so the runtime switch of e.g.
+/// vertexFaceCCD is the same on every call. The templates here take the method
+/// as a template argument instead, e.g.,
+///
+///     ccd::vertexFaceCCD<ccd::CCDMethod::TIGHT_INCLUSION>(...)
+///
+/// so the adapter of the method is resolved at compile time and can be
+/// inlined. Invalid and disabled methods are compile-time errors. Failures at
+/// runtime are reported and answered conservatively like the runtime versions.
+
+#pragma once
+
+#include <ccd.hpp>
+#include <ccd_kernels.hpp>
+
+namespace ccd {
+
+/**
+ * @brief Functor version of vertexFaceCCD with a compile-time method.
+ *
+ * @tparam method  Method of exact CCD. It must be enabled.
+ */
+template <CCDMethod method> struct VertexFaceCCD {
+    static_assert(
+        method >= 0 && method < CCDMethod::NUM_CCD_METHODS,
+        "Invalid CCDMethod");
+    static_assert(is_method_enabled(method), "CCD method is not enabled");
+
+    /// Same as vertexFaceCCD. Returns true if the primitives collide.
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        CCDResult result;
+        return (*this)(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            result, tolerance, max_iter, err);
+    }
+
+    /// Same as vertexFaceCCD, but also computes the time of impact.
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        CCDResult& result,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        const CCDStatus status = kernels::run_kernel(
+            kernels::VertexFaceCCD<method>(), method, result,
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            tolerance, max_iter, err);
+        if (kernels::is_failure(status)) {
+            // Conservative answer upon failure.
+            kernels::report_failure("Vertex-face", method, status);
+        }
+        return result.hit;
+    }
+};
+
+/**
+ * @brief Functor version of edgeEdgeCCD with a compile-time method.
+ *
+ * @tparam method  Method of exact CCD. It must be enabled.
+ */
+template <CCDMethod method> struct EdgeEdgeCCD {
+    static_assert(
+        method >= 0 && method < CCDMethod::NUM_CCD_METHODS,
+        "Invalid CCDMethod");
+    static_assert(is_method_enabled(method), "CCD method is not enabled");
+
+    /// Same as edgeEdgeCCD. Returns true if the primitives collide.
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        CCDResult result;
+        return (*this)(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            result, tolerance, max_iter, err);
+    }
+
+    /// Same as edgeEdgeCCD, but also computes the time of impact.
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        CCDResult& result,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        const CCDStatus status = kernels::run_kernel(
+            kernels::EdgeEdgeCCD<method>(), method, result,
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            tolerance, max_iter, err);
+        if (kernels::is_failure(status)) {
+            // Conservative answer upon failure.
+            kernels::report_failure("Edge-edge", method, status);
+        }
+        return result.hit;
+    }
+};
+
+/**
+ * @brief Functor version of vertexFaceMSCCD with a compile-time method.
+ *
+ * @tparam method  Method of minimum separation CCD. It must be enabled.
+ */
+template <CCDMethod method> struct VertexFaceMSCCD {
+    static_assert(
+        method >= 0 && method < CCDMethod::NUM_CCD_METHODS,
+        "Invalid CCDMethod");
+    static_assert(is_method_enabled(method), "CCD method is not enabled");
+    static_assert(
+        is_minimum_separation_method(method),
+        "CCD method does not support minimum separation");
+
+    /// Same as vertexFaceMSCCD. Returns true if the primitives collide.
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double min_distance,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        CCDResult result;
+        return (*this)(
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            min_distance, result, tolerance, max_iter, err);
+    }
+
+    /// Same as vertexFaceMSCCD, but also computes the time of impact.
+    bool operator()(
+        const Eigen::Vector3d& vertex_start,
+        const Eigen::Vector3d& face_vertex0_start,
+        const Eigen::Vector3d& face_vertex1_start,
+        const Eigen::Vector3d& face_vertex2_start,
+        const Eigen::Vector3d& vertex_end,
+        const Eigen::Vector3d& face_vertex0_end,
+        const Eigen::Vector3d& face_vertex1_end,
+        const Eigen::Vector3d& face_vertex2_end,
+        const double min_distance,
+        CCDResult& result,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        const CCDStatus status = kernels::run_kernel(
+            kernels::VertexFaceMSCCD<method>(), method, result,
+            // Point at t=0
+            vertex_start,
+            // Triangle at t = 0
+            face_vertex0_start, face_vertex1_start, face_vertex2_start,
+            // Point at t=1
+            vertex_end,
+            // Triangle at t = 1
+            face_vertex0_end, face_vertex1_end, face_vertex2_end,
+            min_distance, tolerance, max_iter, err);
+        if (kernels::is_failure(status)) {
+            // Conservative answer upon failure.
+            kernels::report_failure("Vertex-face", method, status);
+        }
+        return result.hit;
+    }
+};
+
+/**
+ * @brief Functor version of edgeEdgeMSCCD with a compile-time method.
+ *
+ * @tparam method  Method of minimum separation CCD. It must be enabled.
+ */
+template <CCDMethod method> struct EdgeEdgeMSCCD {
+    static_assert(
+        method >= 0 && method < CCDMethod::NUM_CCD_METHODS,
+        "Invalid CCDMethod");
+    static_assert(is_method_enabled(method), "CCD method is not enabled");
+    static_assert(
+        is_minimum_separation_method(method),
+        "CCD method does not support minimum separation");
+
+    /// Same as edgeEdgeMSCCD. Returns true if the primitives collide.
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double min_distance,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        CCDResult result;
+        return (*this)(
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            min_distance, result, tolerance, max_iter, err);
+    }
+
+    /// Same as edgeEdgeMSCCD, but also computes the time of impact.
+    bool operator()(
+        const Eigen::Vector3d& edge0_vertex0_start,
+        const Eigen::Vector3d& edge0_vertex1_start,
+        const Eigen::Vector3d& edge1_vertex0_start,
+        const Eigen::Vector3d& edge1_vertex1_start,
+        const Eigen::Vector3d& edge0_vertex0_end,
+        const Eigen::Vector3d& edge0_vertex1_end,
+        const Eigen::Vector3d& edge1_vertex0_end,
+        const Eigen::Vector3d& edge1_vertex1_end,
+        const double min_distance,
+        CCDResult& result,
+        const double tolerance = 1e-6,
+        const long max_iter = 1'000'000,
+        const Eigen::Array3d& err = { -1, 0, 0 }) const
+    {
+        const CCDStatus status = kernels::run_kernel(
+            kernels::EdgeEdgeMSCCD<method>(), method, result,
+            // Edge 1 at t=0
+            edge0_vertex0_start, edge0_vertex1_start,
+            // Edge 2 at t=0
+            edge1_vertex0_start, edge1_vertex1_start,
+            // Edge 1 at t=1
+            edge0_vertex0_end, edge0_vertex1_end,
+            // Edge 2 at t=1
+            edge1_vertex0_end, edge1_vertex1_end,
+            min_distance, tolerance, max_iter, err);
+        if (kernels::is_failure(status)) {
+            // Conservative answer upon failure.
+            kernels::report_failure("Edge-edge", method, status);
+        }
+        return result.hit;
+    }
+};
+
+/// Same as vertexFaceCCD, but with a compile-time method.
+template <CCDMethod method>
+bool vertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return VertexFaceCCD<method>()(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        tolerance, max_iter, err);
+}
+
+/// Same as above, but also computes the time of impact.
+template <CCDMethod method>
+bool vertexFaceCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return VertexFaceCCD<method>()(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        result, tolerance, max_iter, err);
+}
+
+/// Same as edgeEdgeCCD, but with a compile-time method.
+template <CCDMethod method>
+bool edgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return EdgeEdgeCCD<method>()(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        tolerance, max_iter, err);
+}
+
+/// Same as above, but also computes the time of impact.
+template <CCDMethod method>
+bool edgeEdgeCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return EdgeEdgeCCD<method>()(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        result, tolerance, max_iter, err);
+}
+
+/// Same as vertexFaceMSCCD, but with a compile-time method.
+template <CCDMethod method>
+bool vertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return VertexFaceMSCCD<method>()(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, tolerance, max_iter, err);
+}
+
+/// Same as above, but also computes the time of impact.
+template <CCDMethod method>
+bool vertexFaceMSCCD(
+    const Eigen::Vector3d& vertex_start,
+    const Eigen::Vector3d& face_vertex0_start,
+    const Eigen::Vector3d& face_vertex1_start,
+    const Eigen::Vector3d& face_vertex2_start,
+    const Eigen::Vector3d& vertex_end,
+    const Eigen::Vector3d& face_vertex0_end,
+    const Eigen::Vector3d& face_vertex1_end,
+    const Eigen::Vector3d& face_vertex2_end,
+    const double min_distance,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return VertexFaceMSCCD<method>()(
+        // Point at t=0
+        vertex_start,
+        // Triangle at t = 0
+        face_vertex0_start, face_vertex1_start, face_vertex2_start,
+        // Point at t=1
+        vertex_end,
+        // Triangle at t = 1
+        face_vertex0_end, face_vertex1_end, face_vertex2_end,
+        min_distance, result, tolerance, max_iter, err);
+}
+
+/// Same as edgeEdgeMSCCD, but with a compile-time method.
+template <CCDMethod method>
+bool edgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return EdgeEdgeMSCCD<method>()(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, tolerance, max_iter, err);
+}
+
+/// Same as above, but also computes the time of impact.
+template <CCDMethod method>
+bool edgeEdgeMSCCD(
+    const Eigen::Vector3d& edge0_vertex0_start,
+    const Eigen::Vector3d& edge0_vertex1_start,
+    const Eigen::Vector3d& edge1_vertex0_start,
+    const Eigen::Vector3d& edge1_vertex1_start,
+    const Eigen::Vector3d& edge0_vertex0_end,
+    const Eigen::Vector3d& edge0_vertex1_end,
+    const Eigen::Vector3d& edge1_vertex0_end,
+    const Eigen::Vector3d& edge1_vertex1_end,
+    const double min_distance,
+    CCDResult& result,
+    const double tolerance = 1e-6,
+    const long max_iter = 1'000'000,
+    const Eigen::Array3d& err = { -1, 0, 0 })
+{
+    return EdgeEdgeMSCCD<method>()(
+        // Edge 1 at t=0
+        edge0_vertex0_start, edge0_vertex1_start,
+        // Edge 2 at t=0
+        edge1_vertex0_start, edge1_vertex1_start,
+        // Edge 1 at t=1
+        edge0_vertex0_end, edge0_vertex1_end,
+        // Edge 2 at t=1
+        edge1_vertex0_end, edge1_vertex1_end,
+        min_distance, result, tolerance, max_iter, err);
+}
+
+} // namespace ccd
@@ -0,0 +1,255 @@
+// Sweep and prune broad phase sorted incrementally every time step
+#include "ccd_sweep_and_prune.hpp"
+
+#include <algorithm>
+
+namespace ccd {
+
+namespace {
+
+    // Axis of greatest variance of the centers of the boxes
+    int variance_axis(
+        const std::vector<SweptBox>& vertex_boxes,
+        const std::vector<SweptBox>& edge_boxes,
+        const std::vector<SweptBox>& face_boxes)
+    {
+        Eigen::Array3d sum = Eigen::Array3d::Zero();
+        Eigen::Array3d sum_squares = Eigen::Array3d::Zero();
+        double n = 0;
+        for (const std::vector<SweptBox>* boxes :
+             { &vertex_boxes, &edge_boxes, &face_boxes }) {
+            for (const SweptBox& box : *boxes) {
+                const Eigen::Array3d center = 0.5 * (box.min + box.max);
+                sum += center;
+                sum_squares += center.square();
+            }
+            n += boxes->size();
+        }
+        if (n == 0) {
+            return 0;
+        }
+        int axis;
+        (sum_squares / n - (sum / n).square()).maxCoeff(&axis);
+        return axis;
+    }
+
+    // Number of moves after which an insertion sort is slower than sorting
+    // from scratch
+    size_t max_swaps(const size_t n)
+    {
+        size_t log_n = 1;
+        while ((size_t(1) << log_n) <= n) {
+            log_n++;
+        }
+        return n * log_n;
+    }
+
+    // Sort a nearly sorted list by the minimum of its boxes with an
+    // insertion sort, or from scratch if it takes more than max_swaps moves.
+    // Returns whether the list was sorted from scratch.
+    template <typename Entry>
+    bool insertion_sort(std::vector<Entry>& list, size_t& swaps)
+    {
+        const size_t budget = max_swaps(list.size());
+        size_t moves = 0;
+        for (size_t i = 1; i < list.size(); i++) {
+            const Entry entry = list[i];
+            size_t j = i;
+            for (; j > 0 && list[j - 1].min > entry.min; j--) {
+                list[j] = list[j - 1];
+            }
+            list[j] = entry;
+            moves += i - j;
+            if (moves > budget) {
+                swaps += moves;
+                std::sort(
+                    list.begin(), list.end(),
+                    [](const Entry& a, const Entry& b) {
+                        return a.min < b.min;
+                    });
+                return true;
+            }
+        }
+        swaps += moves;
+        return false;
+    }
+
+} // namespace
+
+void SweepAndPrune::build(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius)
+{
+    edges = E;
+    faces = F;
+    adjacency = MeshAdjacency(E, F);
+    update_boxes(/*executor=*/nullptr, V0, V1, inflation_radius);
+    sort(/*executor=*/nullptr, /*from_scratch=*/true);
+}
+
+void SweepAndPrune::build(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius)
+{
+    edges = E;
+    faces = F;
+    adjacency = MeshAdjacency(E, F);
+    update_boxes(&executor, V0, V1, inflation_radius);
+    sort(&executor, /*from_scratch=*/true);
+}
+
+bool SweepAndPrune::update(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    update_boxes(/*executor=*/nullptr, V0, V1, inflation_radius);
+    return sort(/*executor=*/nullptr, /*from_scratch=*/false);
+}
+
+bool SweepAndPrune::update(
+    Executor& executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    update_boxes(&executor, V0, V1, inflation_radius);
+    return sort(&executor, /*from_scratch=*/false);
+}
+
+void SweepAndPrune::update_boxes(
+    Executor* executor,
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const double inflation_radius)
+{
+    broad_phase::swept_boxes(
+        executor, V0, V1, edges, faces, inflation_radius, vertex_boxes,
+        edge_boxes, face_boxes);
+    if (vertex_face_list.size() != vertex_boxes.size() + face_boxes.size()
+        || edge_list.size() != edge_boxes.size()) {
+        vertex_face_list.clear();
+        for (long v = 0; v < long(vertex_boxes.size()); v++) {
+            vertex_face_list.push_back({ 0, 0, v, false });
+        }
+        for (long f = 0; f < long(face_boxes.size()); f++) {
+            vertex_face_list.push_back({ 0, 0, f, true });
+        }
+        edge_list.clear();
+        for (long e = 0; e < long(edge_boxes.size()); e++) {
+            edge_list.push_back({ 0, 0, e, false });
+        }
+    }
+}
+
+bool SweepAndPrune::sort(Executor* executor, bool from_scratch)
+{
+    const int axis = variance_axis(vertex_boxes, edge_boxes, face_boxes);
+    if (axis != sort_axis) {
+        sort_axis = axis;
+        from_scratch = true;
+    }
+
+    // Extents of the boxes along the axis, in the order of the last sort
+    broad_phase::parallel_for(
+        executor, vertex_face_list.size(),
+        [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                Entry& entry = vertex_face_list[i];
+                const SweptBox& box = entry.is_face ? face_boxes[entry.id]
+                                                    : vertex_boxes[entry.id];
+                entry.min = box.min[axis];
+                entry.max = box.max[axis];
+            }
+        });
+    broad_phase::parallel_for(
+        executor, edge_list.size(), [&](const size_t begin, const size_t end) {
+            for (size_t i = begin; i < end; i++) {
+                edge_list[i].min = edge_boxes[edge_list[i].id].min[axis];
+                edge_list[i].max = edge_boxes[edge_list[i].id].max[axis];
+            }
+        });
+
+    swaps = 0;
+    if (from_scratch) {
+        for (std::vector<Entry>* list : { &vertex_face_list, &edge_list }) {
+            std::sort(
+                list->begin(), list->end(),
+                [](const Entry& a, const Entry& b) { return a.min < b.min; });
+        }
+        return true;
+    }
+    // Sort both lists even if the first one is sorted from scratch.
+    const bool vertex_face_sorted = insertion_sort(vertex_face_list, swaps);
+    const bool edge_sorted = insertion_sort(edge_list, swaps);
+    return vertex_face_sorted || edge_sorted;
+}
+
+void SweepAndPrune::candidates(
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(/*executor=*/nullptr, vf_candidates, ee_candidates);
+}
+
+void SweepAndPrune::candidates(
+    Executor& executor,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    candidates(&executor, vf_candidates, ee_candidates);
+}
+
+void SweepAndPrune::candidates(
+    Executor* executor,
+    std::vector<VertexFaceCandidate>& vf_candidates,
+    std::vector<EdgeEdgeCandidate>& ee_candidates) const
+{
+    // Each box is compared to the following boxes of the list that start
+    // before it ends along the axis, so every pair is found once.
+    const MeshAdjacency* culled = broad_phase::culling(adjacency);
+    broad_phase::gather_candidates(
+        executor, vertex_face_list.size(), vf_candidates,
+        [&](const size_t i, std::vector<VertexFaceCandidate>& found) {
+            const Entry& a = vertex_face_list[i];
+            for (size_t j = i + 1; j < vertex_face_list.size()
+                 && vertex_face_list[j].min <= a.max;
+                 j++) {
+                const Entry& b = vertex_face_list[j];
+                if (a.is_face == b.is_face) {
+                    continue;
+                }
+                const long v = a.is_face ? b.id : a.id;
+                const long f = a.is_face ? a.id : b.id;
+                const VertexFaceCandidate candidate { v, f };
+                if (vertex_boxes[v].intersects(face_boxes[f])
+                    && !broad_phase::is_culled(culled, candidate)) {
+                    found.push_back(candidate);
+                }
+            }
+        });
+    broad_phase::gather_candidates(
+        executor, edge_list.size(), ee_candidates,
+        [&](const size_t i, std::vector<EdgeEdgeCandidate>& found) {
+            const Entry& a = edge_list[i];
+            for (size_t j = i + 1;
+                 j < edge_list.size() && edge_list[j].min <= a.max; j++) {
+                const Entry& b = edge_list[j];
+                const EdgeEdgeCandidate candidate { std::min(a.id, b.id),
+                                                    std::max(a.id, b.id) };
+                if (edge_boxes[a.id].intersects(edge_boxes[b.id])
+                    && !broad_phase::is_culled(culled, candidate)) {
+                    found.push_back(candidate);
+                }
+            }
+        });
+}
+
+} // namespace ccd
@@ -0,0 +1,138 @@
+/// @brief Sweep and prune broad phase sorted incrementally every time step
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_broad_phase.hpp>
+
+namespace ccd {
+
+/**
+ * @brief Sweep and prune of the swept boxes of the vertices, edges, and faces
+ *        of a mesh with a fixed topology.
+ *
+ * The boxes are sorted by their minimum along the axis of greatest variance
+ * of their centers, the vertices and faces in one list and the edges in
+ * another. The order is kept between time steps, and an update re-sorts the
+ * lists with an insertion sort, which is linear when the order barely
+ * changes. When the order changes too much, or the axis changes, the lists
+ * are sorted from scratch.
+ *
+ * The candidates skip the pairs of adjacent primitives if the adjacency
+ * culling is enabled (see setAdjacencyCulling). They can be passed to the
+ * mesh functions (e.g., meshVertexFaceCCD).
+ */
+class SweepAndPrune {
+public:
+    /**
+     * @brief Sort the boxes of a moving mesh.
+     *
+     * @param[in] V0                #V × 3 vertex positions at the start.
+     * @param[in] V1                #V × 3 vertex positions at the end.
+     * @param[in] E                 #E × 2 vertex indices of the edges.
+     * @param[in] F                 #F × 3 vertex indices of the faces.
+     * @param[in] inflation_radius  Distance by which the boxes are inflated
+     *                              (e.g., the minimum separation distance).
+     */
+    void build(
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const double inflation_radius = 0);
+
+    /// Same as above, but the boxes are computed by the threads of an
+    /// executor.
+    void build(
+        Executor& executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const Eigen::MatrixXi& E,
+        const Eigen::MatrixXi& F,
+        const double inflation_radius = 0);
+
+    /**
+     * @brief Re-sort the boxes for new positions of the mesh, starting from
+     *        their order at the previous time step.
+     *
+     * @param[in] V0                #V × 3 vertex positions at the start.
+     * @param[in] V1                #V × 3 vertex positions at the end.
+     * @param[in] inflation_radius  Distance by which the boxes are inflated.
+     *
+     * @returns Whether the lists were sorted from scratch instead of
+     *          incrementally.
+     */
+    bool update(
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius = 0);
+
+    /// Same as above, but the boxes are computed by the threads of an
+    /// executor.
+    bool update(
+        Executor& executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius = 0);
+
+    /**
+     * @brief Find the candidate pairs of primitives of the mesh.
+     *
+     * @param[out] vf_candidates  Vertex-face pairs whose boxes intersect.
+     * @param[out] ee_candidates  Pairs of distinct edges whose boxes
+     *                            intersect, with edge0_id < edge1_id.
+     */
+    void candidates(
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /// Same as above, but the lists are swept by the threads of an executor,
+    /// each from a different segment.
+    void candidates(
+        Executor& executor,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    /// Axis along which the boxes are sorted.
+    int axis() const { return sort_axis; }
+
+    /// Number of moves of the insertion sorts of the last update, which is
+    /// small when the order barely changed.
+    size_t num_swaps() const { return swaps; }
+
+private:
+    /// Box of a primitive in a sorted list
+    struct Entry {
+        double min;   ///< Minimum of the box along the axis
+        double max;   ///< Maximum of the box along the axis
+        long id;      ///< Primitive
+        bool is_face; ///< Whether the primitive is a face or a vertex
+    };
+
+    void update_boxes(
+        Executor* executor,
+        const Eigen::MatrixXd& V0,
+        const Eigen::MatrixXd& V1,
+        const double inflation_radius);
+    bool sort(Executor* executor, bool from_scratch);
+    void candidates(
+        Executor* executor,
+        std::vector<VertexFaceCandidate>& vf_candidates,
+        std::vector<EdgeEdgeCandidate>& ee_candidates) const;
+
+    Eigen::MatrixXi edges, faces;
+    MeshAdjacency adjacency;
+    std::vector<SweptBox> vertex_boxes, edge_boxes, face_boxes;
+    /// Vertices and faces sorted by the minimum of their boxes
+    std::vector<Entry> vertex_face_list;
+    /// Edges sorted by the minimum of their boxes
+    std::vector<Entry> edge_list;
+    int sort_axis = 0;
+    size_t swaps = 0;
+};
+
+} // namespace ccd
@@ -0,0 +1,399 @@
+// Per-thread memory reused across CCD queries
+#include "ccd_workspace.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+// The rational methods compute with GMP numbers.
+#if CCD_WRAPPER_WITH_RRP || CCD_WRAPPER_WITH_RFRP
+#include <gmp.h>
+#define CCD_WRAPPER_WORKSPACE_WITH_GMP 1
+#else
+#define CCD_WRAPPER_WORKSPACE_WITH_GMP 0
+#endif
+
+namespace ccd {
+
+namespace {
+
+    // Blocks of 16, 32, ..., 2048 bytes. Larger allocations go to the heap.
+    const size_t MIN_BLOCK_SIZE = 16;
+    const int NUM_SIZE_CLASSES = 8;
+
+    // The arena is split into pages holding blocks of a single size class, so
+    // the size of a block is known from its address alone.
+    const size_t PAGE_SIZE = size_t(1) << 14;
+
+    // Smallest size class fitting size, or NUM_SIZE_CLASSES if none does.
+    int size_class(const size_t size)
+    {
+        int c = 0;
+        while (c < NUM_SIZE_CLASSES && (MIN_BLOCK_SIZE << c) < size) {
+            c++;
+        }
+        return c;
+    }
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    void push(FreeBlock*& list, void* ptr)
+    {
+        FreeBlock* block = static_cast<FreeBlock*>(ptr);
+        block->next = list;
+        list = block;
+    }
+
+    thread_local Workspace* bound_workspace = nullptr;
+
+} // namespace
+
+struct Workspace::Impl {
+    size_t arena_size;
+    char* arena = nullptr; // Allocated on the first allocation
+    std::vector<unsigned char> page_classes;
+    size_t num_pages = 0;
+
+    // Only used by the thread of the workspace.
+    FreeBlock* free_lists[NUM_SIZE_CLASSES] = {};
+    char* page_begin[NUM_SIZE_CLASSES] = {};
+    char* page_end[NUM_SIZE_CLASSES] = {};
+    size_t num_heap_allocations = 0;
+
+    // Blocks handed out and not yet returned to the free lists.
+    size_t num_in_use = 0;
+
+    // Blocks freed on other threads, guarded by the registry mutex.
+    FreeBlock* remote_frees[NUM_SIZE_CLASSES] = {};
+    std::atomic<size_t> num_remote_frees { 0 };
+    // Set when the workspace is destroyed while some blocks are in use.
+    bool orphaned = false;
+
+    ~Impl() { std::free(arena); }
+
+    bool owns(const void* ptr) const
+    {
+        const char* p = static_cast<const char*>(ptr);
+        return arena != nullptr && p >= arena && p < arena + arena_size;
+    }
+
+    size_t block_size(const void* ptr) const
+    {
+        const size_t page = (static_cast<const char*>(ptr) - arena) / PAGE_SIZE;
+        return MIN_BLOCK_SIZE << page_classes[page];
+    }
+
+    // Take a block of size class c, or return nullptr if the arena is full.
+    void* pop(const int c)
+    {
+        if (free_lists[c] == nullptr && num_remote_frees > 0) {
+            reclaim_remote_frees();
+        }
+        void* block = free_lists[c];
+        if (block != nullptr) {
+            free_lists[c] = free_lists[c]->next;
+        } else if (page_begin[c] != page_end[c] || new_page(c)) {
+            block = page_begin[c];
+            page_begin[c] += MIN_BLOCK_SIZE << c;
+        } else {
+            return nullptr;
+        }
+        num_in_use++;
+        return block;
+    }
+
+    bool new_page(const int c)
+    {
+        if (arena == nullptr && !allocate_arena()) {
+            return false;
+        }
+        if (num_pages == page_classes.size()) {
+            return false;
+        }
+        page_classes[num_pages] = static_cast<unsigned char>(c);
+        page_begin[c] = arena + num_pages * PAGE_SIZE;
+        page_end[c] = page_begin[c] + PAGE_SIZE;
+        num_pages++;
+        return true;
+    }
+
+    bool allocate_arena()
+    {
+        arena = static_cast<char*>(std::malloc(arena_size));
+        if (arena == nullptr) {
+            arena_size = 0;
+            return false;
+        }
+        page_classes.resize(arena_size / PAGE_SIZE);
+
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.workspaces.push_back(this);
+        const std::uintptr_t begin = reinterpret_cast<std::uintptr_t>(arena);
+        r.min_address = std::min<std::uintptr_t>(r.min_address, begin);
+        r.max_address =
+            std::max<std::uintptr_t>(r.max_address, begin + arena_size);
+        return true;
+    }
+
+    void reclaim_remote_frees()
+    {
+        std::lock_guard<std::mutex> lock(registry().mutex);
+        for (int c = 0; c < NUM_SIZE_CLASSES; c++) {
+            while (remote_frees[c] != nullptr) {
+                FreeBlock* block = remote_frees[c];
+                remote_frees[c] = block->next;
+                push(free_lists[c], block);
+            }
+        }
+        num_in_use -= num_remote_frees;
+        num_remote_frees = 0;
+    }
+
+    // Arenas of all workspaces, so a block freed on another thread can be
+    // returned to its workspace. Never destroyed, because GMP may free memory
+    // during static destruction.
+    struct Registry {
+        std::mutex mutex;
+        std::vector<Impl*> workspaces;
+        // Bounds of all arenas, to skip the lock for heap memory.
+        std::atomic<std::uintptr_t> min_address { UINTPTR_MAX };
+        std::atomic<std::uintptr_t> max_address { 0 };
+
+        bool may_own(const void* ptr) const
+        {
+            const std::uintptr_t p = reinterpret_cast<std::uintptr_t>(ptr);
+            return p >= min_address && p < max_address;
+        }
+    };
+
+    static Registry& registry()
+    {
+        static Registry* r = new Registry;
+        return *r;
+    }
+
+    // Free a block that is not owned by the workspace of the calling thread.
+    static void release(void* ptr)
+    {
+        if (!release_arena_block(ptr)) {
+            std::free(ptr);
+        }
+    }
+
+    // Return a block to the workspace owning it, or return false if ptr is
+    // not in an arena.
+    static bool release_arena_block(void* ptr)
+    {
+        Registry& r = registry();
+        if (r.may_own(ptr)) {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (auto it = r.workspaces.begin(); it != r.workspaces.end();
+                 ++it) {
+                Impl* owner = *it;
+                if (!owner->owns(ptr)) {
+                    continue;
+                }
+                if (!owner->orphaned) {
+                    const int c = size_class(owner->block_size(ptr));
+                    push(owner->remote_frees[c], ptr);
+                    owner->num_remote_frees++;
+                } else if (--owner->num_in_use == 0) {
+                    r.workspaces.erase(it);
+                    delete owner;
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+
+    // Size of the arena block at ptr, or zero if ptr is heap memory.
+    static size_t arena_block_size(const void* ptr)
+    {
+        Workspace* workspace = bound_workspace;
+        if (workspace != nullptr && workspace->impl->owns(ptr)) {
+            return workspace->impl->block_size(ptr);
+        }
+        Registry& r = registry();
+        if (r.may_own(ptr)) {
+            std::lock_guard<std::mutex> lock(r.mutex);
+            for (const Impl* owner : r.workspaces) {
+                if (owner->owns(ptr)) {
+                    return owner->block_size(ptr);
+                }
+            }
+        }
+        return 0;
+    }
+
+#if CCD_WRAPPER_WORKSPACE_WITH_GMP
+    // GMP memory functions using the arena of the workspace of the calling
+    // thread. Memory outside the arenas belongs to the functions installed
+    // before, which allocate when no workspace is bound, the redirection is
+    // disabled, or the arena is full.
+
+    struct GMPFunctions {
+        void* (*allocate)(size_t);
+        void* (*reallocate)(void*, size_t, size_t);
+        void (*free)(void*, size_t);
+    };
+
+    static GMPFunctions& previous_gmp_functions()
+    {
+        static GMPFunctions functions = {};
+        return functions;
+    }
+
+    static std::atomic<bool>& gmp_redirection_flag()
+    {
+        static std::atomic<bool> flag(false);
+        return flag;
+    }
+
+    static void* gmp_allocate(size_t size)
+    {
+        Workspace* workspace = bound_workspace;
+        const int c = size_class(size);
+        if (workspace != nullptr && c < NUM_SIZE_CLASSES
+            && gmp_redirection_flag().load(std::memory_order_relaxed)) {
+            void* ptr = workspace->impl->pop(c);
+            if (ptr != nullptr) {
+                return ptr;
+            }
+            workspace->impl->num_heap_allocations++;
+        }
+        return previous_gmp_functions().allocate(size);
+    }
+
+    static void* gmp_reallocate(void* ptr, size_t old_size, size_t new_size)
+    {
+        const size_t block_size = arena_block_size(ptr);
+        if (block_size == 0) {
+            return previous_gmp_functions().reallocate(ptr, old_size, new_size);
+        }
+        if (new_size <= block_size) {
+            return ptr;
+        }
+        void* new_ptr = gmp_allocate(new_size);
+        std::memcpy(new_ptr, ptr, std::min(old_size, block_size));
+        gmp_free(ptr, old_size);
+        return new_ptr;
+    }
+
+    static void gmp_free(void* ptr, size_t size)
+    {
+        Workspace* workspace = bound_workspace;
+        if (workspace != nullptr && workspace->impl->owns(ptr)) {
+            workspace->deallocate(ptr);
+        } else if (!release_arena_block(ptr)) {
+            previous_gmp_functions().free(ptr, size);
+        }
+    }
+#endif
+};
+
+Workspace::Workspace(size_t arena_size)
+    : impl(new Impl)
+{
+    impl->arena_size = std::max(PAGE_SIZE, arena_size / PAGE_SIZE * PAGE_SIZE);
+}
+
+Workspace::~Workspace()
+{
+    Impl::Registry& r = Impl::registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
+    impl->num_in_use -= impl->num_remote_frees;
+    impl->num_remote_frees = 0;
+    if (impl->num_in_use > 0) {
+        // Deleted by Impl::release() once the last block is freed.
+        impl->orphaned = true;
+        return;
+    }
+    r.workspaces.erase(
+        std::remove(r.workspaces.begin(), r.workspaces.end(), impl),
+        r.workspaces.end());
+    delete impl;
+}
+
+Workspace::Scope::Scope(Workspace& workspace)
+    : previous(bound_workspace)
+{
+    bound_workspace = &workspace;
+}
+
+Workspace::Scope::~Scope() { bound_workspace = previous; }
+
+Workspace* Workspace::current() { return bound_workspace; }
+
+void* Workspace::allocate(const size_t size)
+{
+    const int c = size_class(size);
+    if (c < NUM_SIZE_CLASSES) {
+        void* ptr = impl->pop(c);
+        if (ptr != nullptr) {
+            return ptr;
+        }
+    }
+    impl->num_heap_allocations++;
+    return std::malloc(size);
+}
+
+void Workspace::deallocate(void* ptr)
+{
+    if (ptr == nullptr) {
+        return;
+    }
+    if (impl->owns(ptr)) {
+        push(impl->free_lists[size_class(impl->block_size(ptr))], ptr);
+        impl->num_in_use--;
+    } else {
+        Impl::release(ptr);
+    }
+}
+
+size_t Workspace::num_heap_allocations() const
+{
+    return impl->num_heap_allocations;
+}
+
+bool setWorkspaceGMPAllocation(const bool enabled)
+{
+#if CCD_WRAPPER_WORKSPACE_WITH_GMP
+    // The functions stay installed once enabled, so the blocks of the arenas
+    // are freed by them after the redirection is disabled.
+    static std::once_flag gmp_memory_functions_set;
+    if (enabled) {
+        std::call_once(gmp_memory_functions_set, [] {
+            Workspace::Impl::GMPFunctions& previous =
+                Workspace::Impl::previous_gmp_functions();
+            mp_get_memory_functions(
+                &previous.allocate, &previous.reallocate, &previous.free);
+            mp_set_memory_functions(
+                &Workspace::Impl::gmp_allocate,
+                &Workspace::Impl::gmp_reallocate, &Workspace::Impl::gmp_free);
+        });
+    }
+    Workspace::Impl::gmp_redirection_flag().store(enabled);
+    return true;
+#else
+    return !enabled;
+#endif
+}
+
+bool isWorkspaceGMPAllocationEnabled()
+{
+#if CCD_WRAPPER_WORKSPACE_WITH_GMP
+    return Workspace::Impl::gmp_redirection_flag().load();
+#else
+    return false;
+#endif
+}
+
+} // namespace ccd
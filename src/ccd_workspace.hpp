@@ -0,0 +1,116 @@
+/// @brief Per-thread memory reused across CCD queries
+
+#pragma once
+
+#include <cstddef>
+
+namespace ccd {
+
+/**
+ * @brief Memory reused across the CCD queries of one thread.
+ *
+ * The rational methods (RATIONAL_ROOT_PARITY and RATIONAL_FIXED_ROOT_PARITY)
+ * compute with GMP numbers, which allocate on every arithmetic operation. If
+ * enabled with setWorkspaceGMPAllocation, the GMP allocations of a thread
+ * bound to a workspace (see Scope) are served from free lists in an arena
+ * owned by the workspace. After the first few queries, the rational methods
+ * make no heap allocations on that thread and do not contend with other
+ * threads on the global allocator.
+ *
+ * The executor binds a workspace to each of its threads, so the batched and
+ * mesh functions taking an Executor use them once enabled. Callers running
+ * their own threads bind one workspace per thread.
+ *
+ * Only the GMP allocations are served from the workspace. The other methods
+ * allocate with operator new inside their libraries (e.g., the interval queue
+ * of Tight Inclusion), which the wrapper cannot redirect, and the interval
+ * methods do not allocate.
+ *
+ * A workspace must not be used by more than one thread at a time. Memory may
+ * be freed on any thread, and memory still in use when a workspace is
+ * destroyed stays valid until it is freed.
+ */
+class Workspace {
+public:
+    /// Default number of bytes of the arena.
+    static const size_t DEFAULT_ARENA_SIZE = size_t(1) << 20;
+
+    /**
+     * @brief Create a workspace.
+     *
+     * @param[in] arena_size  Bytes reserved for small allocations. The arena
+     *                        is allocated on the first allocation.
+     */
+    explicit Workspace(size_t arena_size = DEFAULT_ARENA_SIZE);
+    ~Workspace();
+
+    Workspace(const Workspace&) = delete;
+    Workspace& operator=(const Workspace&) = delete;
+
+    /// Binds a workspace to the calling thread for the lifetime of the scope.
+    class Scope {
+    public:
+        explicit Scope(Workspace& workspace);
+        ~Scope();
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        Workspace* previous;
+    };
+
+    /// Workspace bound to the calling thread, or nullptr if there is none.
+    static Workspace* current();
+
+    /**
+     * @brief Allocate memory from the workspace.
+     *
+     * Must be called on the thread using the workspace. Falls back to the heap
+     * for large sizes and once the arena is full.
+     *
+     * @param[in] size  Number of bytes.
+     *
+     * @returns Memory aligned like std::malloc.
+     */
+    void* allocate(size_t size);
+
+    /**
+     * @brief Free memory from allocate() of any workspace or from std::malloc.
+     *
+     * @param[in] ptr  Memory to free.
+     */
+    void deallocate(void* ptr);
+
+    /// Number of allocations that were not served from the arena.
+    size_t num_heap_allocations() const;
+
+private:
+    friend bool setWorkspaceGMPAllocation(bool enabled);
+    friend bool isWorkspaceGMPAllocationEnabled();
+
+    struct Impl;
+    Impl* impl; // Outlives the workspace while its memory is in use.
+};
+
+/**
+ * @brief Enable or disable serving the GMP allocations of the threads bound to
+ *        a workspace from its arena.
+ *
+ * Disabled by default. Enabling it the first time installs memory functions
+ * in GMP for the whole process, which forward the memory outside the arenas
+ * to the functions installed before (e.g., by the application), so the
+ * memory they allocated remains valid. The functions stay installed when the
+ * redirection is disabled, so the blocks still in use are freed by them. GMP's
+ * memory functions must not be replaced afterwards.
+ *
+ * @param[in] enabled  Whether to redirect the GMP allocations.
+ *
+ * @returns False if enabled but the build does not use GMP.
+ */
+bool setWorkspaceGMPAllocation(bool enabled);
+
+/// Whether the GMP allocations are served from the workspaces.
+bool isWorkspaceGMPAllocationEnabled();
+
+} // namespace ccd
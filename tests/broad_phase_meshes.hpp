@@ -0,0 +1,114 @@
+#pragma once
+
+#include <algorithm>
+#include <random>
+#include <set>
+#include <utility>
+#include <vector>
+
+#include <Eigen/Core>
+
+#include <ccd_broad_phase.hpp>
+
+// A crumpled n × n grid of triangles moving randomly, with its edges.
+inline void random_cloth(
+    const int n,
+    const unsigned seed,
+    Eigen::MatrixXd& V0,
+    Eigen::MatrixXd& V1,
+    Eigen::MatrixXi& E,
+    Eigen::MatrixXi& F)
+{
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<double> noise(-1, 1);
+
+    const double h = 1.0 / n;
+    V0.resize((n + 1) * (n + 1), 3);
+    for (int i = 0; i <= n; i++) {
+        for (int j = 0; j <= n; j++) {
+            V0.row(i * (n + 1) + j) << i * h, j * h, 2 * h * noise(gen);
+        }
+    }
+    V1 = V0;
+    for (int i = 0; i < V1.rows(); i++) {
+        V1.row(i) += h * Eigen::RowVector3d(noise(gen), noise(gen), noise(gen));
+    }
+
+    F.resize(2 * n * n, 3);
+    for (int i = 0; i < n; i++) {
+        for (int j = 0; j < n; j++) {
+            const int v = i * (n + 1) + j;
+            F.row(2 * (i * n + j)) << v, v + n + 1, v + 1;
+            F.row(2 * (i * n + j) + 1) << v + 1, v + n + 1, v + n + 2;
+        }
+    }
+
+    std::set<std::pair<int, int>> edges;
+    for (int f = 0; f < F.rows(); f++) {
+        for (int k = 0; k < 3; k++) {
+            const int a = F(f, k), b = F(f, (k + 1) % 3);
+            edges.emplace(std::min(a, b), std::max(a, b));
+        }
+    }
+    E.resize(edges.size(), 2);
+    int e = 0;
+    for (const auto& edge : edges) {
+        E.row(e++) << edge.first, edge.second;
+    }
+}
+
+// Candidates of a brute force broad phase, without the pairs of adjacent
+// primitives if the adjacency culling is enabled
+inline void brute_force_candidates(
+    const Eigen::MatrixXd& V0,
+    const Eigen::MatrixXd& V1,
+    const Eigen::MatrixXi& E,
+    const Eigen::MatrixXi& F,
+    const double inflation_radius,
+    std::vector<ccd::VertexFaceCandidate>& vf_candidates,
+    std::vector<ccd::EdgeEdgeCandidate>& ee_candidates)
+{
+    std::vector<ccd::SweptBox> vertex_boxes, edge_boxes, face_boxes;
+    ccd::sweptBoxes(
+        V0, V1, E, F, inflation_radius, vertex_boxes, edge_boxes, face_boxes);
+    const bool cull = ccd::isAdjacencyCullingEnabled();
+    vf_candidates.clear();
+    for (long v = 0; v < long(vertex_boxes.size()); v++) {
+        for (long f = 0; f < long(face_boxes.size()); f++) {
+            if (cull && (F.row(f).array() == int(v)).any()) {
+                continue;
+            }
+            if (vertex_boxes[v].intersects(face_boxes[f])) {
+                vf_candidates.push_back({ v, f });
+            }
+        }
+    }
+    ee_candidates.clear();
+    for (long e0 = 0; e0 < long(edge_boxes.size()); e0++) {
+        for (long e1 = e0 + 1; e1 < long(edge_boxes.size()); e1++) {
+            if (cull
+                && ((E.row(e1).array() == E(e0, 0)).any()
+                    || (E.row(e1).array() == E(e0, 1)).any())) {
+                continue;
+            }
+            if (edge_boxes[e0].intersects(edge_boxes[e1])) {
+                ee_candidates.push_back({ e0, e1 });
+            }
+        }
+    }
+}
+
+namespace ccd {
+
+inline bool
+operator==(const VertexFaceCandidate& a, const VertexFaceCandidate& b)
+{
+    return a.vertex_id == b.vertex_id && a.face_id == b.face_id;
+}
+
+inline bool operator==(const EdgeEdgeCandidate& a, const EdgeEdgeCandidate& b)
+{
+    return a.edge0_id == b.edge0_id && a.edge1_id == b.edge1_id;
+}
+
+} // namespace ccd
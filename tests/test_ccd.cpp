@@ -384,3 +384,118 @@ TEST_CASE("Teseo test case 2", "[!mayfail][ccd][edge-edge][teseo2]")
         CHECK(hit == expected_hit);
     }
 }
+
+TEST_CASE("Noexcept CCD status", "[ccd][status]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    CAPTURE(method_names[method]);
+
+    // A vertex falling through the middle of a triangle
+    const Eigen::Vector3d v0(0, 1, 0), v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+    const Eigen::Vector3d v0_end(0, -1, 0);
+
+    CCDResult result;
+    const CCDStatus status =
+        tryVertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method, result);
+
+    if (!is_method_enabled(method)) {
+        CHECK(status == CCDStatus::DISABLED);
+        CHECK(result.hit);
+        CHECK(result.toi == 0);
+        return;
+    }
+
+    CHECK((status == CCDStatus::OK || status == CCDStatus::HIT));
+    CHECK(result.hit == (status == CCDStatus::HIT));
+    CHECK(
+        result.hit
+        == vertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method));
+
+    const CCDStatus ms_status = tryVertexFaceMSCCD(
+        v0, v1, v2, v3, v0_end, v1, v2, v3, 1e-3, method, result);
+    if (is_minimum_separation_method(method)) {
+        CHECK((ms_status == CCDStatus::OK || ms_status == CCDStatus::HIT));
+    } else {
+        CHECK(ms_status == CCDStatus::FAILED);
+        CHECK(result.hit);
+    }
+}
+
+TEST_CASE("Noexcept CCD with an invalid method", "[ccd][status]")
+{
+    using namespace ccd;
+    const Eigen::Vector3d a0(-1, -1, 0), a1(1, -1, 0);
+    const Eigen::Vector3d b0(0, 1, -1), b1(0, 1, 1);
+
+    CCDResult result;
+    const CCDStatus status = tryEdgeEdgeCCD(
+        a0, a1, b0, b1, a0, a1, b0, b1, CCDMethod::NUM_CCD_METHODS, result);
+    CHECK(status == CCDStatus::FAILED);
+    CHECK(result.hit);
+    CHECK(result.toi == 0);
+}
+
+TEST_CASE("Single precision CCD", "[ccd][float]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    CAPTURE(method_names[method]);
+
+    // A vertex falling through the middle of a triangle, or stopping short
+    const float v0_end_y = GENERATE(-1.0f, 0.5f);
+    const Eigen::Vector3f v0(0, 1, 0), v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+    const Eigen::Vector3f v0_end(0, v0_end_y, 0);
+
+    // Two edges crossing at the end, or passing each other
+    const float b_end_z = GENERATE(0.0f, 2.0f);
+    const Eigen::Vector3f a0(-1, 0, 0), a1(1, 0, 0);
+    const Eigen::Vector3f b0(0, -1, 1), b1(0, 1, 1);
+    const Eigen::Vector3f b0_end(0, -1, b_end_z), b1_end(0, 1, b_end_z);
+
+    CCDResult result;
+    const CCDStatus vf_status =
+        tryVertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method, result);
+    const CCDStatus ee_status = tryEdgeEdgeCCD(
+        a0, a1, b0, b1, a0, a1, b0_end, b1_end, method, result);
+
+    if (!is_method_enabled(method)) {
+        CHECK(vf_status == CCDStatus::DISABLED);
+        CHECK(ee_status == CCDStatus::DISABLED);
+        return;
+    }
+    CHECK((vf_status == CCDStatus::OK || vf_status == CCDStatus::HIT));
+    CHECK((ee_status == CCDStatus::OK || ee_status == CCDStatus::HIT));
+
+    // The float queries promote exactly to the double queries.
+    const auto d = [](const Eigen::Vector3f& x) -> Eigen::Vector3d {
+        return x.cast<double>();
+    };
+    const bool vf_hit = vertexFaceCCD(
+        d(v0), d(v1), d(v2), d(v3), d(v0_end), d(v1), d(v2), d(v3), method);
+    const bool ee_hit = edgeEdgeCCD(
+        d(a0), d(a1), d(b0), d(b1), d(a0), d(a1), d(b0_end), d(b1_end),
+        method);
+    CHECK((vf_status == CCDStatus::HIT) == vf_hit);
+    CHECK((ee_status == CCDStatus::HIT) == ee_hit);
+    CHECK(
+        vertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method) == vf_hit);
+    CHECK(
+        edgeEdgeCCD(a0, a1, b0, b1, a0, a1, b0_end, b1_end, method)
+        == ee_hit);
+
+    if (is_time_of_impact_computed(method) && ee_hit) {
+        CHECK(edgeEdgeCCD(
+            a0, a1, b0, b1, a0, a1, b0_end, b1_end, method, result));
+        CHECK(result.toi <= 1);
+    }
+
+    const CCDStatus ms_status = tryVertexFaceMSCCD(
+        v0, v1, v2, v3, v0_end, v1, v2, v3, 1e-3f, method, result);
+    if (is_minimum_separation_method(method)) {
+        CHECK((ms_status == CCDStatus::OK || ms_status == CCDStatus::HIT));
+    } else {
+        CHECK(ms_status == CCDStatus::FAILED);
+        CHECK(result.hit);
+    }
+}
@@ -0,0 +1,109 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include <ccd_adjacency.hpp>
+#include <ccd_bvh.hpp>
+#include <ccd_spatial_hash.hpp>
+#include <ccd_sweep_and_prune.hpp>
+
+#include "broad_phase_meshes.hpp"
+
+using namespace ccd;
+
+TEST_CASE("Adjacency of the primitives of a mesh", "[ccd][adjacency]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    // More than 64 vertices, so that the classes of some vertices collide.
+    random_cloth(10, 0, V0, V1, E, F);
+    const MeshAdjacency adjacency(E, F);
+
+    for (long v = 0; v < V0.rows(); v++) {
+        for (long f = 0; f < F.rows(); f++) {
+            const bool expected = F(f, 0) == v || F(f, 1) == v || F(f, 2) == v;
+            if (adjacency.is_adjacent(VertexFaceCandidate { v, f })
+                != expected) {
+                FAIL_CHECK("vertex " << v << " face " << f);
+            }
+        }
+    }
+    for (long e0 = 0; e0 < E.rows(); e0++) {
+        for (long e1 = 0; e1 < E.rows(); e1++) {
+            const bool expected = E(e0, 0) == E(e1, 0) || E(e0, 0) == E(e1, 1)
+                || E(e0, 1) == E(e1, 0) || E(e0, 1) == E(e1, 1);
+            if (adjacency.is_adjacent(EdgeEdgeCandidate { e0, e1 })
+                != expected) {
+                FAIL_CHECK("edges " << e0 << " and " << e1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Cull adjacent candidates", "[ccd][adjacency]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    std::vector<VertexFaceCandidate> all_vf, expected_vf;
+    std::vector<EdgeEdgeCandidate> all_ee, expected_ee;
+    setAdjacencyCulling(false);
+    brute_force_candidates(V0, V1, E, F, 0, all_vf, all_ee);
+    setAdjacencyCulling(true);
+    brute_force_candidates(V0, V1, E, F, 0, expected_vf, expected_ee);
+    REQUIRE(expected_vf.size() < all_vf.size());
+    REQUIRE(expected_ee.size() < all_ee.size());
+
+    resetAdjacencyCullingStats();
+    std::vector<VertexFaceCandidate> vf_candidates = all_vf;
+    std::vector<EdgeEdgeCandidate> ee_candidates = all_ee;
+    cullAdjacentCandidates(E, F, vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+    const AdjacencyCullingStats stats = adjacencyCullingStats();
+    CHECK(stats.num_vf_culled == all_vf.size() - expected_vf.size());
+    CHECK(stats.num_ee_culled == all_ee.size() - expected_ee.size());
+}
+
+TEST_CASE("Broad phases cull adjacent candidates", "[ccd][adjacency]")
+{
+    const bool enabled = GENERATE(false, true);
+    CAPTURE(enabled);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    setAdjacencyCulling(enabled);
+    CHECK(isAdjacencyCullingEnabled() == enabled);
+    std::vector<VertexFaceCandidate> expected_vf;
+    std::vector<EdgeEdgeCandidate> expected_ee;
+    brute_force_candidates(V0, V1, E, F, 0, expected_vf, expected_ee);
+
+    std::vector<VertexFaceCandidate> vf_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    Executor executor(4);
+
+    resetAdjacencyCullingStats();
+    spatialHashCandidates(executor, V0, V1, E, F, vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+    const AdjacencyCullingStats stats = adjacencyCullingStats();
+    CHECK((stats.num_vf_culled > 0) == enabled);
+    CHECK((stats.num_ee_culled > 0) == enabled);
+
+    MeshBVH bvh;
+    bvh.build(V0, V1, E, F);
+    bvh.candidates(executor, vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    SweepAndPrune sap;
+    sap.build(V0, V1, E, F);
+    sap.candidates(executor, vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    setAdjacencyCulling(true);
+}
@@ -0,0 +1,318 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ccd.hpp>
+#include <ccd_batch.hpp>
+
+static const double EPSILON = std::numeric_limits<float>::epsilon();
+
+namespace {
+
+void append_query(
+    std::vector<double>& queries,
+    const Eigen::Vector3d& x0,
+    const Eigen::Vector3d& x1,
+    const Eigen::Vector3d& x2,
+    const Eigen::Vector3d& x3,
+    const Eigen::Vector3d& x4,
+    const Eigen::Vector3d& x5,
+    const Eigen::Vector3d& x6,
+    const Eigen::Vector3d& x7)
+{
+    for (const Eigen::Vector3d* x :
+         { &x0, &x1, &x2, &x3, &x4, &x5, &x6, &x7 }) {
+        queries.insert(queries.end(), x->data(), x->data() + 3);
+    }
+}
+
+Eigen::Vector3d point(const std::vector<double>& queries, size_t query, int i)
+{
+    return Eigen::Map<const Eigen::Vector3d>(
+        queries.data() + ccd::QUERY_SIZE * query + 3 * i);
+}
+
+// Point-triangle queries from "Test Point-Triangle Continuous Collision
+// Detection" in test_ccd.cpp.
+std::vector<double> vertex_face_queries()
+{
+    std::vector<double> queries;
+    const Eigen::Vector3d v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+    for (double v0z : { 0.0, -1.0 }) {
+        const Eigen::Vector3d v0(0, 1, v0z);
+        for (double u0y : { -1.0, 0.0, 0.5 - EPSILON, 0.5, 0.5 + EPSILON }) {
+            for (double u1y : { -1.0, 0.0, 0.5 - EPSILON, 0.5, 1.0, 2.0 }) {
+                const Eigen::Vector3d u0(0, -u0y, EPSILON), u1(0, u1y, 0);
+                append_query(
+                    queries, v0, v1, v2, v3, v0 + u0, v1 + u1, v2 + u1,
+                    v3 + u1);
+            }
+        }
+    }
+    return queries;
+}
+
+// Edge-edge queries from "Test Edge-Edge Continuous Collision Detection" in
+// test_ccd.cpp.
+std::vector<double> edge_edge_queries()
+{
+    std::vector<double> queries;
+    const Eigen::Vector3d v0(-1, -1, 0), v1(1, -1, 0);
+    for (double e1x : { -1 - EPSILON, -1.0, -0.5, 0.0, 1.0, 1 + EPSILON }) {
+        const Eigen::Vector3d v2(e1x, 1, -1), v3(e1x, 1, 1);
+        for (double y : { -1.0, 0.0, 1 - EPSILON, 1.0, 1 + EPSILON, 2.0 }) {
+            const Eigen::Vector3d u0(0, y, 0), u1(0, -y, 0);
+            append_query(
+                queries, v0, v1, v2, v3, v0 + u0, v1 + u0, v2 + u1, v3 + u1);
+        }
+    }
+    return queries;
+}
+
+} // namespace
+
+TEST_CASE("Batched CCD matches scalar CCD", "[ccd][batch]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    SECTION("Vertex-face")
+    {
+        const std::vector<double> queries = vertex_face_queries();
+        const size_t n = queries.size() / QUERY_SIZE;
+        std::unique_ptr<bool[]> hits(new bool[n]);
+        vertexFaceCCDBatch(queries.data(), n, method, hits.get());
+        for (size_t i = 0; i < n; i++) {
+            CAPTURE(i);
+            CHECK(
+                hits[i]
+                == vertexFaceCCD(
+                    point(queries, i, 0), point(queries, i, 1),
+                    point(queries, i, 2), point(queries, i, 3),
+                    point(queries, i, 4), point(queries, i, 5),
+                    point(queries, i, 6), point(queries, i, 7), method));
+        }
+    }
+
+    SECTION("Edge-edge")
+    {
+        const std::vector<double> queries = edge_edge_queries();
+        const size_t n = queries.size() / QUERY_SIZE;
+        std::unique_ptr<bool[]> hits(new bool[n]);
+        edgeEdgeCCDBatch(queries.data(), n, method, hits.get());
+        for (size_t i = 0; i < n; i++) {
+            CAPTURE(i);
+            CHECK(
+                hits[i]
+                == edgeEdgeCCD(
+                    point(queries, i, 0), point(queries, i, 1),
+                    point(queries, i, 2), point(queries, i, 3),
+                    point(queries, i, 4), point(queries, i, 5),
+                    point(queries, i, 6), point(queries, i, 7), method));
+        }
+    }
+
+    SECTION("Boxes closer than the default minimum separation")
+    {
+        // MSRF looks for collisions within DEFAULT_MIN_DISTANCE, so the boxes
+        // must not be culled.
+        std::vector<double> queries;
+        const Eigen::Vector3d v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+        const Eigen::Vector3d v0(0, 5e-9, 0), v0_end(0.5, 5e-9, 0);
+        append_query(queries, v0, v1, v2, v3, v0_end, v1, v2, v3);
+        const Eigen::Vector3d d(0, 0, 1e-3);
+        append_query(queries, v0, v1, v2, v3, v0_end, v1 + d, v2 + d, v3 + d);
+        bool hits[2];
+        vertexFaceCCDBatch(queries.data(), 2, method, hits);
+        for (size_t i = 0; i < 2; i++) {
+            CAPTURE(i);
+            const bool expected = vertexFaceCCD(
+                point(queries, i, 0), point(queries, i, 1),
+                point(queries, i, 2), point(queries, i, 3),
+                point(queries, i, 4), point(queries, i, 5),
+                point(queries, i, 6), point(queries, i, 7), method);
+            if (method == CCDMethod::MIN_SEPARATION_ROOT_FINDER) {
+                CHECK(hits[i]);
+                CHECK(expected);
+            } else {
+                // The other methods miss both queries, but a conservative
+                // method may report a false positive within its numerical
+                // error (e.g., Tight Inclusion in single precision), which the
+                // exact culling answers as a miss.
+                CHECK(!hits[i]);
+                CHECK((!expected || is_conservative_method(method)));
+            }
+        }
+    }
+}
+
+TEST_CASE("Batched MSCCD matches scalar MSCCD", "[ccd][batch][msccd]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method) || !is_minimum_separation_method(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    const double min_distance = GENERATE(0.0, 1e-3, 0.1);
+
+    SECTION("Vertex-face")
+    {
+        const std::vector<double> queries = vertex_face_queries();
+        const size_t n = queries.size() / QUERY_SIZE;
+        std::unique_ptr<bool[]> hits(new bool[n]);
+        vertexFaceMSCCDBatch(
+            queries.data(), n, min_distance, method, hits.get());
+        for (size_t i = 0; i < n; i++) {
+            CAPTURE(i);
+            CHECK(
+                hits[i]
+                == vertexFaceMSCCD(
+                    point(queries, i, 0), point(queries, i, 1),
+                    point(queries, i, 2), point(queries, i, 3),
+                    point(queries, i, 4), point(queries, i, 5),
+                    point(queries, i, 6), point(queries, i, 7), min_distance,
+                    method));
+        }
+    }
+
+    SECTION("Edge-edge")
+    {
+        const std::vector<double> queries = edge_edge_queries();
+        const size_t n = queries.size() / QUERY_SIZE;
+        std::unique_ptr<bool[]> hits(new bool[n]);
+        edgeEdgeMSCCDBatch(queries.data(), n, min_distance, method, hits.get());
+        for (size_t i = 0; i < n; i++) {
+            CAPTURE(i);
+            CHECK(
+                hits[i]
+                == edgeEdgeMSCCD(
+                    point(queries, i, 0), point(queries, i, 1),
+                    point(queries, i, 2), point(queries, i, 3),
+                    point(queries, i, 4), point(queries, i, 5),
+                    point(queries, i, 6), point(queries, i, 7), min_distance,
+                    method));
+        }
+    }
+}
+
+TEST_CASE("Batched CCD returns the time of impact", "[ccd][batch][toi]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    const auto check_result = [&](const CCDResult& actual, bool hit,
+                                  const CCDResult& expected) {
+        CHECK(actual.hit == hit);
+        CHECK(actual.hit == expected.hit);
+        CHECK(actual.toi == expected.toi);
+        if (actual.hit) {
+            // The output tolerance of a miss is unspecified (see CCDResult).
+            CHECK(actual.output_tolerance == expected.output_tolerance);
+            CHECK(actual.toi >= 0);
+            CHECK(actual.toi <= 1);
+        } else {
+            CHECK(actual.toi == std::numeric_limits<double>::infinity());
+        }
+    };
+
+    SECTION("Vertex-face")
+    {
+        const std::vector<double> queries = vertex_face_queries();
+        const size_t n = queries.size() / QUERY_SIZE;
+        std::vector<CCDResult> results(n);
+        vertexFaceCCDBatch(queries.data(), n, method, results.data());
+        for (size_t i = 0; i < n; i++) {
+            CAPTURE(i);
+            CCDResult expected;
+            const bool hit = vertexFaceCCD(
+                point(queries, i, 0), point(queries, i, 1),
+                point(queries, i, 2), point(queries, i, 3),
+                point(queries, i, 4), point(queries, i, 5),
+                point(queries, i, 6), point(queries, i, 7), method);
+            vertexFaceCCD(
+                point(queries, i, 0), point(queries, i, 1),
+                point(queries, i, 2), point(queries, i, 3),
+                point(queries, i, 4), point(queries, i, 5),
+                point(queries, i, 6), point(queries, i, 7), method, expected);
+            check_result(results[i], hit, expected);
+        }
+    }
+
+    SECTION("Edge-edge")
+    {
+        const std::vector<double> queries = edge_edge_queries();
+        const size_t n = queries.size() / QUERY_SIZE;
+        std::vector<CCDResult> results(n);
+        edgeEdgeCCDBatch(queries.data(), n, method, results.data());
+        for (size_t i = 0; i < n; i++) {
+            CAPTURE(i);
+            CCDResult expected;
+            const bool hit = edgeEdgeCCD(
+                point(queries, i, 0), point(queries, i, 1),
+                point(queries, i, 2), point(queries, i, 3),
+                point(queries, i, 4), point(queries, i, 5),
+                point(queries, i, 6), point(queries, i, 7), method);
+            edgeEdgeCCD(
+                point(queries, i, 0), point(queries, i, 1),
+                point(queries, i, 2), point(queries, i, 3),
+                point(queries, i, 4), point(queries, i, 5),
+                point(queries, i, 6), point(queries, i, 7), method, expected);
+            check_result(results[i], hit, expected);
+        }
+    }
+}
+
+TEST_CASE(
+    "Batched results do not depend on the previous queries", "[ccd][batch][toi]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    // A hit against a static face, whose time of impact 1/3 is bracketed,
+    // then a hit against a moving face, and a miss against the static face
+    // whose boxes intersect. The miss is not culled, so its output tolerance
+    // is the one of the scalar function.
+    std::vector<double> queries;
+    const Eigen::Vector3d a(-1, 0, 1), b(1, 0, 1), c(0, 0, -1);
+    const Eigen::Vector3d v0(0, 1, 0), v0_end(0, -2, 0);
+    const Eigen::Vector3d d(0, 0.25, 0), beside(0.9, 0, -0.9);
+    append_query(queries, v0, a, b, c, v0_end, a, b, c);
+    append_query(queries, v0, a, b, c, v0_end, a + d, b + d, c + d);
+    append_query(queries, v0 + beside, a, b, c, v0_end + beside, a, b, c);
+
+    const size_t n = queries.size() / QUERY_SIZE;
+    std::vector<CCDResult> results(n);
+    vertexFaceCCDBatch(queries.data(), n, method, results.data());
+    for (size_t i = 0; i < n; i++) {
+        CAPTURE(i);
+        CCDResult expected;
+        vertexFaceCCD(
+            point(queries, i, 0), point(queries, i, 1), point(queries, i, 2),
+            point(queries, i, 3), point(queries, i, 4), point(queries, i, 5),
+            point(queries, i, 6), point(queries, i, 7), method, expected);
+        CHECK(results[i].hit == (i < 2));
+        CHECK(results[i].hit == expected.hit);
+        CHECK(results[i].toi == expected.toi);
+        CHECK(results[i].output_tolerance == expected.output_tolerance);
+    }
+}
@@ -0,0 +1,167 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include <ccd_bvh.hpp>
+
+#include "broad_phase_meshes.hpp"
+
+using namespace ccd;
+
+TEST_CASE("BVH matches brute force", "[ccd][broad_phase][bvh]")
+{
+    const double inflation_radius = GENERATE(0.0, 1e-2);
+    CAPTURE(inflation_radius);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    std::vector<VertexFaceCandidate> expected_vf;
+    std::vector<EdgeEdgeCandidate> expected_ee;
+    brute_force_candidates(
+        V0, V1, E, F, inflation_radius, expected_vf, expected_ee);
+    REQUIRE(!expected_vf.empty());
+    REQUIRE(!expected_ee.empty());
+
+    std::vector<VertexFaceCandidate> vf_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    MeshBVH bvh;
+    bvh.build(V0, V1, E, F, inflation_radius);
+    bvh.candidates(vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    Executor executor(4);
+    bvh.build(executor, V0, V1, E, F, inflation_radius);
+    bvh.candidates(executor, vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    SECTION("Refitted to the next time step")
+    {
+        Eigen::MatrixXd V2, unused_V0;
+        Eigen::MatrixXi unused_E, unused_F;
+        random_cloth(10, 1, unused_V0, V2, unused_E, unused_F);
+        brute_force_candidates(
+            V1, V2, E, F, inflation_radius, expected_vf, expected_ee);
+
+        // Never rebuild, so that the refitted hierarchies are traversed.
+        bvh.rebuild_threshold = std::numeric_limits<double>::infinity();
+        CHECK(!bvh.update(executor, V1, V2, inflation_radius));
+        CHECK(bvh.num_rebuilds() == 0);
+        bvh.candidates(executor, vf_candidates, ee_candidates);
+        CHECK(vf_candidates == expected_vf);
+        CHECK(ee_candidates == expected_ee);
+
+        // Always rebuild
+        bvh.rebuild_threshold = 0;
+        CHECK(bvh.update(V1, V2, inflation_radius));
+        CHECK(bvh.num_rebuilds() == 1);
+        CHECK(bvh.cost_ratio() == Approx(1));
+        bvh.candidates(vf_candidates, ee_candidates);
+        CHECK(vf_candidates == expected_vf);
+        CHECK(ee_candidates == expected_ee);
+    }
+}
+
+TEST_CASE("BVH rebuilds degraded hierarchies", "[ccd][broad_phase][bvh]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    MeshBVH bvh;
+    bvh.build(V0, V0, E, F);
+    CHECK(bvh.cost_ratio() == 1);
+
+    // Same motion, so the refitted hierarchies are as good as the built ones.
+    CHECK(!bvh.update(V0 * 2, V0 * 2));
+    CHECK(bvh.cost_ratio() == Approx(1));
+
+    // Shuffle the vertices, so that every node spans most of the cloth.
+    std::vector<long> order(V0.rows());
+    std::iota(order.begin(), order.end(), 0);
+    std::shuffle(order.begin(), order.end(), std::mt19937(0));
+    Eigen::MatrixXd shuffled(V0.rows(), 3);
+    for (long i = 0; i < V0.rows(); i++) {
+        shuffled.row(i) = V0.row(order[i]);
+    }
+    CHECK(bvh.update(V0, shuffled));
+    CHECK(bvh.num_rebuilds() == 1);
+    CHECK(bvh.cost_ratio() == 1);
+}
+
+TEST_CASE("BVH between two meshes", "[ccd][broad_phase][bvh]")
+{
+    Eigen::MatrixXd V0, V1, W0, W1;
+    Eigen::MatrixXi E, F, G, H;
+    random_cloth(6, 0, V0, V1, E, F);
+    random_cloth(5, 1, W0, W1, G, H);
+
+    // Brute force on the union of the meshes
+    Eigen::MatrixXd U0(V0.rows() + W0.rows(), 3), U1(U0.rows(), 3);
+    U0 << V0, W0;
+    U1 << V1, W1;
+    Eigen::MatrixXi UE(E.rows() + G.rows(), 2), UF(F.rows() + H.rows(), 3);
+    UE << E, G.array() + int(V0.rows());
+    UF << F, H.array() + int(V0.rows());
+    std::vector<VertexFaceCandidate> union_vf;
+    std::vector<EdgeEdgeCandidate> union_ee;
+    brute_force_candidates(U0, U1, UE, UF, 0, union_vf, union_ee);
+
+    std::vector<VertexFaceCandidate> expected_vf, expected_fv;
+    for (const VertexFaceCandidate& c : union_vf) {
+        if (c.vertex_id < V0.rows() && c.face_id >= F.rows()) {
+            expected_vf.push_back({ c.vertex_id, c.face_id - F.rows() });
+        } else if (c.vertex_id >= V0.rows() && c.face_id < F.rows()) {
+            expected_fv.push_back({ c.vertex_id - V0.rows(), c.face_id });
+        }
+    }
+    std::vector<EdgeEdgeCandidate> expected_ee;
+    for (const EdgeEdgeCandidate& c : union_ee) {
+        if (c.edge0_id < E.rows() && c.edge1_id >= E.rows()) {
+            expected_ee.push_back({ c.edge0_id, c.edge1_id - E.rows() });
+        }
+    }
+    REQUIRE(!expected_vf.empty());
+    REQUIRE(!expected_fv.empty());
+    REQUIRE(!expected_ee.empty());
+
+    MeshBVH bvh, other;
+    bvh.build(V0, V1, E, F);
+    other.build(W0, W1, G, H);
+
+    std::vector<VertexFaceCandidate> vf_candidates, fv_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    bvh.candidates(other, vf_candidates, fv_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(fv_candidates == expected_fv);
+    CHECK(ee_candidates == expected_ee);
+
+    Executor executor(4);
+    bvh.candidates(
+        executor, other, vf_candidates, fv_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(fv_candidates == expected_fv);
+    CHECK(ee_candidates == expected_ee);
+}
+
+TEST_CASE("BVH of an empty mesh", "[ccd][broad_phase][bvh]")
+{
+    std::vector<VertexFaceCandidate> vf_candidates = { { 0, 0 } };
+    std::vector<EdgeEdgeCandidate> ee_candidates = { { 0, 1 } };
+
+    MeshBVH bvh;
+    bvh.build(
+        Eigen::MatrixXd(0, 3), Eigen::MatrixXd(0, 3), Eigen::MatrixXi(0, 2),
+        Eigen::MatrixXi(0, 3));
+    CHECK(!bvh.update(Eigen::MatrixXd(0, 3), Eigen::MatrixXd(0, 3)));
+    bvh.candidates(vf_candidates, ee_candidates);
+    CHECK(vf_candidates.empty());
+    CHECK(ee_candidates.empty());
+}
@@ -0,0 +1,106 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+
+#include <ccd.hpp>
+#include <ccd_cascade.hpp>
+
+using namespace ccd;
+
+TEST_CASE("Precision cascade tiers", "[ccd][cascade]")
+{
+    if (!is_method_enabled(CCDMethod::PRECISION_CASCADE)) {
+        return;
+    }
+    const CCDMethod method = CCDMethod::PRECISION_CASCADE;
+    resetPrecisionCascadeStats();
+
+    // The face moves, so the static obstacle kernels do not answer first.
+    const Eigen::Vector3d v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+    const Eigen::Vector3d v3_end(0, 0, -1.1);
+
+    SECTION("Negative resolved by the coarse tier")
+    {
+        const Eigen::Vector3d v0(0, 2, 0), v0_end(0, 1, 0);
+        CHECK(!vertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3_end, method));
+        const CascadeStats stats = precisionCascadeStats();
+        CHECK(stats.num_queries == 1);
+        CHECK(stats.num_resolved[COARSE_TIGHT_INCLUSION_TIER] == 1);
+        CHECK(stats.resolved_rate(COARSE_TIGHT_INCLUSION_TIER) == 1);
+    }
+
+    SECTION("Positive resolved by Tight Inclusion")
+    {
+        const Eigen::Vector3d v0(0, 1, 0), v0_end(0, -1, 0);
+        CCDResult result;
+        CHECK(vertexFaceCCD(
+            v0, v1, v2, v3, v0_end, v1, v2, v3_end, method, result));
+        CHECK(result.toi <= 0.5);
+        CHECK(result.output_tolerance <= 1e-6);
+        const CascadeStats stats = precisionCascadeStats();
+        CHECK(stats.num_queries == 1);
+        CHECK(stats.num_resolved[TIGHT_INCLUSION_TIER] == 1);
+    }
+
+    SECTION("Positive out of iterations escalated")
+    {
+        const Eigen::Vector3d a0(-1, 0, 0), a1(1, 0, 0);
+        const Eigen::Vector3d b0(0, -1, 1), b1(0, 1, 1);
+        const Eigen::Vector3d b0_end(0, -1, -1), b1_end(0, 1, -1);
+        CHECK(edgeEdgeCCD(
+            a0, a1, b0, b1, a0, a1, b0_end, b1_end, method,
+            /*tolerance=*/1e-6, /*max_iter=*/1));
+        const CascadeStats stats = precisionCascadeStats();
+        CHECK(stats.num_queries == 1);
+        if (is_method_enabled(CCDMethod::RATIONAL_ROOT_PARITY)) {
+            CHECK(stats.num_resolved[RATIONAL_ROOT_PARITY_TIER] == 1);
+        } else {
+            CHECK(stats.num_unresolved == 1);
+        }
+    }
+}
+
+TEST_CASE("Precision cascade agrees with its tiers", "[ccd][cascade]")
+{
+    if (!is_method_enabled(CCDMethod::PRECISION_CASCADE)) {
+        return;
+    }
+    resetPrecisionCascadeStats();
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(-1, 1);
+
+    const int num_queries = 1000;
+    for (int q = 0; q < num_queries; q++) {
+        Eigen::Vector3d x[8];
+        for (Eigen::Vector3d& xi : x) {
+            xi = Eigen::Vector3d(position(gen), position(gen), position(gen));
+        }
+        CCDResult cascade, tight_inclusion;
+        vertexFaceCCD(
+            x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7],
+            CCDMethod::PRECISION_CASCADE, cascade);
+        vertexFaceCCD(
+            x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7],
+            CCDMethod::TIGHT_INCLUSION, tight_inclusion);
+
+        // Every tier before rational root parity is Tight Inclusion, so the
+        // cascade only differs on the positives it escalated.
+        if (!tight_inclusion.hit
+            || tight_inclusion.output_tolerance <= 1e-6) {
+            CHECK(cascade.hit == tight_inclusion.hit);
+        }
+        if (cascade.hit) {
+            CHECK(cascade.toi == tight_inclusion.toi);
+        }
+    }
+
+    const CascadeStats stats = precisionCascadeStats();
+    CHECK(stats.num_queries == num_queries);
+    uint64_t num_resolved = stats.num_unresolved;
+    for (int i = 0; i < NUM_CASCADE_TIERS; i++) {
+        num_resolved += stats.num_resolved[i];
+    }
+    CHECK(num_resolved == num_queries);
+    CHECK(stats.num_resolved[COARSE_TIGHT_INCLUSION_TIER] > 0);
+}
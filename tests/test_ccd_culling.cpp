@@ -0,0 +1,139 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <ccd.hpp>
+#include <ccd_batch.hpp>
+#include <ccd_culling.hpp>
+
+using namespace ccd;
+
+namespace {
+
+// Random queries in SoA form with primitives of about 0.4 in the unit cube,
+// so many but not all of the queries are culled.
+std::vector<double>
+random_queries(const size_t num_queries, const int num_first_points)
+{
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(0, 1);
+    std::uniform_real_distribution<double> offset(-0.2, 0.2);
+
+    std::vector<double> coordinates(QUERY_SIZE * num_queries);
+    for (size_t i = 0; i < num_queries; i++) {
+        for (int k = 0; k < 3; k++) {
+            const double centers[2] = { position(gen), position(gen) };
+            for (int j = 0; j < 8; j++) {
+                coordinates[(3 * j + k) * num_queries + i] =
+                    centers[j % 4 < num_first_points ? 0 : 1] + offset(gen);
+            }
+        }
+    }
+    return coordinates;
+}
+
+// Whether the swept bounding boxes of a query are at most d apart on all axes.
+bool boxes_overlap(
+    const std::vector<double>& coordinates,
+    const size_t num_queries,
+    const size_t i,
+    const int num_first_points,
+    const double d)
+{
+    for (int k = 0; k < 3; k++) {
+        double a_min = std::numeric_limits<double>::infinity();
+        double b_min = a_min, a_max = -a_min, b_max = -a_min;
+        for (int j = 0; j < 8; j++) {
+            const double x = coordinates[(3 * j + k) * num_queries + i];
+            if (j % 4 < num_first_points) {
+                a_min = std::min(a_min, x);
+                a_max = std::max(a_max, x);
+            } else {
+                b_min = std::min(b_min, x);
+                b_max = std::max(b_max, x);
+            }
+        }
+        // Exact for these coordinates.
+        if ((long double)a_min - b_max > d || (long double)b_min - a_max > d) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Swept bounding box culling", "[culling]")
+{
+    const size_t num_queries = 1001; // Not a multiple of the SIMD width
+    const int num_first_points = GENERATE(1, 2);
+    std::vector<double> coordinates =
+        random_queries(num_queries, num_first_points);
+    const double min_distance = GENERATE(0.0, 0.01);
+    // Queries with NaN coordinates are never culled.
+    coordinates[5 * num_queries + 7] = std::numeric_limits<double>::quiet_NaN();
+
+    std::vector<size_t> expected;
+    for (size_t i = 0; i < num_queries; i++) {
+        if (i == 7
+            || boxes_overlap(
+                coordinates, num_queries, i, num_first_points, min_distance)) {
+            expected.push_back(i);
+        }
+    }
+    REQUIRE(expected.size() > 0);
+    REQUIRE(expected.size() < num_queries / 2);
+
+    for (int level = 0; level <= int(detectedSIMDLevel()); level++) {
+        CAPTURE(level);
+        std::vector<size_t> survivors(num_queries);
+        const size_t num_survivors = kernels::cull_swept_boxes(
+            coordinates.data(), num_queries, num_queries, num_first_points,
+            min_distance, survivors.data(), SIMDLevel(level));
+        survivors.resize(num_survivors);
+        CHECK(survivors == expected);
+    }
+
+    std::vector<size_t> survivors(num_queries);
+    const size_t num_survivors = num_first_points == 1
+        ? cullVertexFaceQueries(
+            coordinates.data(), num_queries, num_queries, min_distance,
+            survivors.data())
+        : cullEdgeEdgeQueries(
+            coordinates.data(), num_queries, num_queries, min_distance,
+            survivors.data());
+    CHECK(num_survivors == expected.size());
+}
+
+TEST_CASE("Batches cull their queries", "[culling][batch]")
+{
+    // A vertex far above a face, and a vertex passing through it
+    const Eigen::Vector3d v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+    const Eigen::Vector3d far(0, 10, 0), through(0, 1, 0);
+    std::vector<double> queries;
+    for (const Eigen::Vector3d& v0 : { far, through }) {
+        const Eigen::Vector3d v0_end = v0 - Eigen::Vector3d(0, 2, 0);
+        for (const Eigen::Vector3d* x :
+             { &v0, &v1, &v2, &v3, &v0_end, &v1, &v2, &v3 }) {
+            queries.insert(queries.end(), x->data(), x->data() + 3);
+        }
+    }
+
+    for (int i = 0; i < NUM_CCD_METHODS; i++) {
+        const CCDMethod method = CCDMethod(i);
+        if (!is_method_enabled(method)) {
+            continue;
+        }
+        CAPTURE(method_names[method]);
+        resetSweptBoxCullingStats();
+        CCDResult results[2];
+        vertexFaceCCDBatch(queries.data(), 2, method, results);
+        CHECK(!results[0].hit);
+        CHECK(results[0].toi == std::numeric_limits<double>::infinity());
+        CHECK(results[1].hit);
+        CHECK(sweptBoxCullingStats().num_queries == 2);
+        CHECK(sweptBoxCullingStats().num_rejected == 1);
+    }
+}
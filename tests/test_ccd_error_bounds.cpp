@@ -0,0 +1,132 @@
+#include <catch2/catch.hpp>
+
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <ccd.hpp>
+#include <ccd_batch.hpp>
+#include <ccd_error_bounds.hpp>
+#include <ccd_mesh.hpp>
+
+using namespace ccd;
+
+TEST_CASE("Error bounds of a bounding box", "[ccd][error_bounds]")
+{
+    SECTION("Vertex-face bounds are larger")
+    {
+        const ErrorBounds bounds = boxErrorBounds(
+            Eigen::Array3d(-0.5, -0.25, 0), Eigen::Array3d(0.125, 1, 2));
+        CHECK((bounds.vertex_face > bounds.edge_edge).all());
+        CHECK((bounds.edge_edge > 0).all());
+        // The coordinates are capped at one.
+        CHECK(bounds.vertex_face[0] == bounds.vertex_face[2] / 8);
+        CHECK(bounds.vertex_face[1] == bounds.vertex_face[2]);
+    }
+
+    SECTION("Minimum separation bounds are larger")
+    {
+        const Eigen::Array3d box_min(-1, -1, -1), box_max(1, 1, 1);
+        const ErrorBounds bounds = boxErrorBounds(box_min, box_max);
+        const ErrorBounds ms_bounds =
+            boxErrorBounds(box_min, box_max, /*minimum_separation=*/true);
+        CHECK((ms_bounds.vertex_face > bounds.vertex_face).all());
+        CHECK((ms_bounds.edge_edge > bounds.edge_edge).all());
+    }
+
+    SECTION("Empty mesh")
+    {
+        const ErrorBounds bounds =
+            meshErrorBounds(Eigen::MatrixXd(0, 3), Eigen::MatrixXd(0, 3));
+        CHECK((bounds.vertex_face == 0).all());
+        CHECK((bounds.edge_edge == 0).all());
+    }
+}
+
+TEST_CASE("Scene error bounds cover every query", "[ccd][error_bounds]")
+{
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(-0.75, 0.5);
+
+    const int num_queries = 100;
+    std::vector<double> queries(QUERY_SIZE * num_queries);
+    for (double& coordinate : queries) {
+        coordinate = position(gen);
+    }
+    const ErrorBounds bounds = batchErrorBounds(queries.data(), num_queries);
+
+    // Same bounds from the vertices of a mesh
+    Eigen::MatrixXd V0(4 * num_queries, 3), V1(4 * num_queries, 3);
+    for (int i = 0; i < num_queries; i++) {
+        for (int j = 0; j < 4; j++) {
+            for (int k = 0; k < 3; k++) {
+                V0(4 * i + j, k) = queries[QUERY_SIZE * i + 3 * j + k];
+                V1(4 * i + j, k) = queries[QUERY_SIZE * i + 3 * (j + 4) + k];
+            }
+        }
+    }
+    const ErrorBounds mesh_bounds = meshErrorBounds(V0, V1);
+    CHECK((mesh_bounds.vertex_face == bounds.vertex_face).all());
+    CHECK((mesh_bounds.edge_edge == bounds.edge_edge).all());
+
+    for (int i = 0; i < num_queries; i++) {
+        const ErrorBounds query_bounds =
+            batchErrorBounds(&queries[QUERY_SIZE * i], 1);
+        CHECK((query_bounds.vertex_face <= bounds.vertex_face).all());
+        CHECK((query_bounds.edge_edge <= bounds.edge_edge).all());
+    }
+}
+
+TEST_CASE(
+    "Earliest time of impact with scene error bounds", "[ccd][error_bounds]")
+{
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    // A static triangle, a vertex falling through it, and a moving edge
+    // crossing two of the triangle's edges
+    Eigen::MatrixXd V0(6, 3);
+    V0 << -1, 0, 1,   //
+        1, 0, 1,      //
+        0, 0, -1,     //
+        0, 1, 0,      //
+        0.25, -1, -1, //
+        0.25, -1, 1.5;
+    Eigen::MatrixXd V1 = V0;
+    V1.row(3) << 0, -1, 0;
+    V1.row(4) << 0.25, 1, -1;
+    V1.row(5) << 0.25, 1, 1.5;
+    Eigen::MatrixXi E(4, 2), F(1, 3);
+    E << 0, 1, 1, 2, 2, 0, 4, 5;
+    F << 0, 1, 2;
+
+    const std::vector<VertexFaceCandidate> vf_candidates = { { 3, 0 } };
+    const std::vector<EdgeEdgeCandidate> ee_candidates = { { 0, 3 },
+                                                           { 1, 3 },
+                                                           { 2, 3 } };
+
+    const ErrorBounds bounds = meshErrorBounds(V0, V1);
+    const double expected =
+        meshEarliestTOI(V0, V1, E, F, vf_candidates, ee_candidates, method);
+    const double toi = meshEarliestTOI(
+        V0, V1, E, F, vf_candidates, ee_candidates, method, 1e-6, 1'000'000,
+        bounds);
+    CHECK(toi == Approx(expected).margin(1e-3));
+
+    CHECK(
+        meshEarliestTOI(V0, V1, E, F, {}, {}, method, 1e-6, 1'000'000, bounds)
+        == std::numeric_limits<double>::infinity());
+
+    const ErrorBounds ms_bounds =
+        meshErrorBounds(V0, V1, /*minimum_separation=*/true);
+    if (is_minimum_separation_method(method)) {
+        CHECK(
+            meshEarliestMSTOI(
+                V0, V1, E, F, vf_candidates, ee_candidates, 1e-3, method,
+                1e-6, 1'000'000, ms_bounds)
+            <= toi + 1e-3);
+    }
+}
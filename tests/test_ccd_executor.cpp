@@ -0,0 +1,80 @@
+#include <catch2/catch.hpp>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include <ccd.hpp>
+#include <ccd_batch.hpp>
+#include <ccd_executor.hpp>
+
+TEST_CASE("Executor covers every index once", "[executor]")
+{
+    const unsigned num_threads = GENERATE(1u, 2u, 3u, 8u);
+    const size_t n = GENERATE(0, 1, 7, 1000, 100'003);
+    CAPTURE(num_threads, n);
+
+    ccd::Executor executor(num_threads);
+    CHECK(executor.num_threads() == num_threads);
+
+    // Run twice to check that the pool can be reused.
+    for (int run = 0; run < 2; run++) {
+        std::unique_ptr<std::atomic<int>[]> counts(new std::atomic<int>[n]);
+        for (size_t i = 0; i < n; i++) {
+            counts[i] = 0;
+        }
+        // Catch2 assertions are not thread safe, so only count here.
+        std::atomic<int> num_bad_chunks(0);
+        executor.parallel_for(n, [&](const size_t begin, const size_t end) {
+            if (begin >= end || end > n) {
+                num_bad_chunks++;
+                return;
+            }
+            for (size_t i = begin; i < end; i++) {
+                counts[i]++;
+            }
+        });
+        CHECK(num_bad_chunks == 0);
+        size_t num_wrong = 0;
+        for (size_t i = 0; i < n; i++) {
+            num_wrong += counts[i] != 1;
+        }
+        CHECK(num_wrong == 0);
+    }
+}
+
+TEST_CASE("Parallel batched CCD matches serial batched CCD", "[ccd][executor]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    // A vertex falling through a triangle with varying horizontal offsets, so
+    // some queries hit and some miss.
+    std::vector<double> queries;
+    const int n = 500;
+    for (int i = 0; i < n; i++) {
+        const double x = 2.0 * i / n - 0.5;
+        const double query[QUERY_SIZE] = {
+            x, 1, 0, -1, 0, 1, 1, 0, 1, 0, 0, -1,  // t = 0
+            x, -1, 0, -1, 0, 1, 1, 0, 1, 0, 0, -1, // t = 1
+        };
+        queries.insert(queries.end(), query, query + QUERY_SIZE);
+    }
+
+    std::vector<CCDResult> expected(n), actual(n);
+    vertexFaceCCDBatch(queries.data(), n, method, expected.data());
+
+    Executor executor(4);
+    vertexFaceCCDBatch(executor, queries.data(), n, method, actual.data());
+
+    for (int i = 0; i < n; i++) {
+        CAPTURE(i);
+        CHECK(actual[i].hit == expected[i].hit);
+        CHECK(actual[i].toi == expected[i].toi);
+    }
+}
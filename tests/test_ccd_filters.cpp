@@ -0,0 +1,418 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+
+#include <ccd.hpp>
+#include <ccd_filters.hpp>
+
+using namespace ccd;
+
+namespace {
+
+// Enables the filter for a method for the lifetime of the object.
+class EnableFilter {
+public:
+    explicit EnableFilter(const CCDMethod method)
+        : filtered_method(method)
+    {
+        setNonPenetrationFilter(method, true);
+    }
+    ~EnableFilter() { setNonPenetrationFilter(filtered_method, false); }
+
+private:
+    const CCDMethod filtered_method;
+};
+
+// Coplanarity function of four linearly moving points at time t.
+long double coplanarity(const Eigen::Vector3d* x, const long double t)
+{
+    Eigen::Matrix<long double, 3, 4> p;
+    for (int i = 0; i < 4; i++) {
+        p.col(i) = (1 - t) * x[i].cast<long double>()
+            + t * x[i + 4].cast<long double>();
+    }
+    Eigen::Matrix<long double, 3, 3> m;
+    m << p.col(1) - p.col(0), p.col(2) - p.col(0), p.col(3) - p.col(0);
+    return m.determinant();
+}
+
+} // namespace
+
+TEST_CASE("Non-penetration filter", "[ccd][filter]")
+{
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    CHECK(!isNonPenetrationFilterEnabled(method));
+    const EnableFilter enable(method);
+    CHECK(isNonPenetrationFilterEnabled(method));
+    resetNonPenetrationFilterStats();
+    // The plain functions of MSRF look for collisions within
+    // DEFAULT_MIN_DISTANCE, so they are not filtered.
+    const size_t filtered =
+        method != CCDMethod::MIN_SEPARATION_ROOT_FINDER ? 1 : 0;
+
+    const Eigen::Vector3d v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+
+    SECTION("Vertex passing through the face")
+    {
+        const Eigen::Vector3d v0(0, 1, 0), v0_end(0, -1, 0);
+        CHECK(vertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method));
+        CHECK(nonPenetrationFilterStats(method).num_queries == filtered);
+        CHECK(nonPenetrationFilterStats(method).num_rejected == 0);
+    }
+
+    SECTION("Vertex moving parallel to the face")
+    {
+        const Eigen::Vector3d v0(0, 1e-3, 0), v0_end(0.5, 1e-3, 0);
+        CHECK(!vertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method));
+        CHECK(nonPenetrationFilterStats(method).num_queries == filtered);
+        CHECK(nonPenetrationFilterStats(method).num_rejected == filtered);
+
+        if (is_minimum_separation_method(method)) {
+            // Not a coplanarity test for a positive minimum separation
+            CHECK(vertexFaceMSCCD(
+                v0, v1, v2, v3, v0_end, v1, v2, v3, 1e-2, method));
+            CHECK(nonPenetrationFilterStats(method).num_queries == filtered);
+        }
+    }
+
+    SECTION("Edges crossing")
+    {
+        const Eigen::Vector3d a0(-1, 0, 0), a1(1, 0, 0);
+        const Eigen::Vector3d b0(0, -1, 1), b1(0, 1, 1);
+        const Eigen::Vector3d b0_end(0, -1, -1), b1_end(0, 1, -1);
+        CHECK(edgeEdgeCCD(a0, a1, b0, b1, a0, a1, b0_end, b1_end, method));
+
+        const Eigen::Vector3d b0_above(0, -1, 2), b1_above(0, 1, 2);
+        CHECK(!edgeEdgeCCD(
+            a0, a1, b0, b1, a0, a1, b0_above, b1_above, method));
+
+        CHECK(nonPenetrationFilterStats(method).num_queries == 2 * filtered);
+        CHECK(nonPenetrationFilterStats(method).num_rejected == filtered);
+    }
+
+    SECTION("Vertex within the default minimum separation")
+    {
+        // Never coplanar, but closer than DEFAULT_MIN_DISTANCE, which MSRF
+        // reports as a collision.
+        const Eigen::Vector3d v0(0, 5e-9, 0), v0_end(0.5, 5e-9, 0);
+        CHECK(
+            vertexFaceCCD(v0, v1, v2, v3, v0_end, v1, v2, v3, method)
+            == (method == CCDMethod::MIN_SEPARATION_ROOT_FINDER));
+        CHECK(nonPenetrationFilterStats(method).num_rejected == filtered);
+    }
+
+    SECTION("Disabled for other methods")
+    {
+        const CCDMethod other = CCDMethod((method + 1) % NUM_CCD_METHODS);
+        CHECK(!isNonPenetrationFilterEnabled(other));
+    }
+}
+
+TEST_CASE("Non-penetration filter is conservative", "[ccd][filter]")
+{
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(-1, 1);
+    std::uniform_real_distribution<double> time(0, 1);
+
+    int num_rejected = 0;
+    for (int q = 0; q < 10'000; q++) {
+        Eigen::Vector3d x[8];
+        for (Eigen::Vector3d& xi : x) {
+            xi = Eigen::Vector3d(position(gen), position(gen), position(gen));
+        }
+        if (q % 2 == 0) {
+            // Make the points coplanar at a random time.
+            const double t = time(gen);
+            const Eigen::Vector3d p = (1 - t) * x[3] + t * x[7];
+            const Eigen::Vector3d p0 = (1 - t) * x[0] + t * x[4];
+            const Eigen::Vector3d p1 = (1 - t) * x[1] + t * x[5];
+            const Eigen::Vector3d p2 = (1 - t) * x[2] + t * x[6];
+            const Eigen::Vector3d n = (p1 - p0).cross(p2 - p0).normalized();
+            x[7] += -n.dot(p - p0) / t * n;
+        }
+
+        if (!kernels::is_never_coplanar(
+                x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7])) {
+            continue;
+        }
+        num_rejected++;
+        // The coplanarity function does not change sign on [0, 1].
+        const long double f0 = coplanarity(x, 0);
+        for (int i = 1; i <= 100; i++) {
+            CHECK(f0 * coplanarity(x, i / 100.0L) > 0);
+        }
+    }
+    CHECK(num_rejected > 0);
+}
+
+TEST_CASE("Root parity filter", "[ccd][filter]")
+{
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    CHECK(isRootParityFilterEnabled());
+    resetRootParityFilterStats();
+
+    const Eigen::Vector3d a0(-1, 0, 0), a1(1, 0, 0);
+    const Eigen::Vector3d b0(0, -1, 1), b1(0, 1, 1);
+    const Eigen::Vector3d b0_end(0, -1, -1), b1_end(0, 1, -1);
+    CHECK(edgeEdgeCCD(a0, a1, b0, b1, a0, a1, b0_end, b1_end, method));
+
+    // Disjoint swept boxes
+    const Eigen::Vector3d b0_above(0, -1, 2), b1_above(0, 1, 2);
+    CHECK(!edgeEdgeCCD(a0, a1, b0, b1, a0, a1, b0_above, b1_above, method));
+
+    // Overlapping swept boxes, but skew edges
+    const Eigen::Vector3d c0(0, -1, 0.5), c1(0, 1, -0.3);
+    const bool skew_hit =
+        edgeEdgeCCD(a0, a1, c0, c1, a0, a1, c0, c1, method);
+    CHECK((!skew_hit || is_conservative_method(method)));
+    CHECK(!kernels::are_swept_boxes_disjoint(
+        /*num_first_points=*/2, { &a0, &a1, &c0, &c1, &a0, &a1, &c0, &c1 }));
+
+    const FilterStats stats = rootParityFilterStats(method);
+    if (kernels::is_root_parity_method(method)) {
+        CHECK(stats.num_queries == 3);
+        CHECK(stats.num_rejected == 2);
+
+        setRootParityFilter(false);
+        CHECK(!edgeEdgeCCD(
+            a0, a1, b0, b1, a0, a1, b0_above, b1_above, method));
+        CHECK(rootParityFilterStats(method).num_queries == 3);
+        setRootParityFilter(true);
+    } else {
+        CHECK(stats.num_queries == 0);
+    }
+}
+
+TEST_CASE("Root parity filter is conservative", "[ccd][filter]")
+{
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> position(-1, 1);
+    std::uniform_real_distribution<double> time(0, 1);
+
+    int num_rejected = 0;
+    for (int q = 0; q < 10'000; q++) {
+        Eigen::Vector3d x[8];
+        for (Eigen::Vector3d& xi : x) {
+            xi = Eigen::Vector3d(position(gen), position(gen), position(gen));
+        }
+        if (q % 2 == 0) {
+            // Make the points coplanar at a random time.
+            const double t = time(gen);
+            const Eigen::Vector3d p = (1 - t) * x[3] + t * x[7];
+            const Eigen::Vector3d p0 = (1 - t) * x[0] + t * x[4];
+            const Eigen::Vector3d p1 = (1 - t) * x[1] + t * x[5];
+            const Eigen::Vector3d p2 = (1 - t) * x[2] + t * x[6];
+            const Eigen::Vector3d n = (p1 - p0).cross(p2 - p0).normalized();
+            x[7] += -n.dot(p - p0) / t * n;
+        }
+
+        const Eigen::Vector3d* const points[8] = {
+            &x[0], &x[1], &x[2], &x[3], &x[4], &x[5], &x[6], &x[7]
+        };
+        if (!kernels::is_never_coplanar_semi_static(points)) {
+            continue;
+        }
+        num_rejected++;
+        // The coplanarity function does not change sign on [0, 1].
+        const long double f0 = coplanarity(x, 0);
+        for (int i = 1; i <= 100; i++) {
+            CHECK(f0 * coplanarity(x, i / 100.0L) > 0);
+        }
+    }
+    CHECK(num_rejected > 0);
+}
+
+TEST_CASE("Zero-motion detection", "[ccd][filter]")
+{
+    using kernels::RelativeMotion;
+    Eigen::Vector3d x[8] = {
+        { 0, 1, 0 }, { -1, 0, 1 }, { 1, 0, 1 }, { 0, 0, -1 },
+        { 0, 1, 0 }, { -1, 0, 1 }, { 1, 0, 1 }, { 0, 0, -1 },
+    };
+    const Eigen::Vector3d* const points[8] = {
+        &x[0], &x[1], &x[2], &x[3], &x[4], &x[5], &x[6], &x[7]
+    };
+    CHECK(kernels::relative_motion(points) == RelativeMotion::STATIC);
+
+    for (int i = 4; i < 8; i++) {
+        x[i] += Eigen::Vector3d(0.25, -0.5, 2);
+    }
+    CHECK(kernels::relative_motion(points) == RelativeMotion::TRANSLATION);
+
+    x[7].x() += 1e-3;
+    CHECK(kernels::relative_motion(points) == RelativeMotion::GENERAL);
+
+    // 0.1 + 0.2 - 0.1 is not 0.2, so the displacements are not exact.
+    for (int i = 0; i < 4; i++) {
+        x[i].x() = 0.1;
+        x[i + 4].x() = 0.1 + 0.2;
+    }
+    x[0].x() = 0.2;
+    x[4].x() = 0.2 + 0.2;
+    CHECK(kernels::relative_motion(points) == RelativeMotion::GENERAL);
+}
+
+TEST_CASE("Zero-motion fast path", "[ccd][filter]")
+{
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    CHECK(isZeroMotionFastPathEnabled());
+    resetZeroMotionStats();
+
+    const Eigen::Vector3d v1(-1, 0, 1), v2(1, 0, 1), v3(0, 0, -1);
+
+    SECTION("Resting vertex above the face")
+    {
+        const Eigen::Vector3d v0(0, 0.5, 0);
+        CHECK(!vertexFaceCCD(v0, v1, v2, v3, v0, v1, v2, v3, method));
+        const ZeroMotionStats stats = zeroMotionStats();
+        CHECK(stats.num_queries == 1);
+        CHECK(stats.num_static == 1);
+        CHECK(stats.num_answered == 1);
+
+        if (is_minimum_separation_method(method)) {
+            CHECK(!vertexFaceMSCCD(
+                v0, v1, v2, v3, v0, v1, v2, v3, 0.1, method));
+            CHECK(vertexFaceMSCCD(v0, v1, v2, v3, v0, v1, v2, v3, 1, method));
+            CHECK(zeroMotionStats().num_answered == 2);
+        }
+    }
+
+    SECTION("Resting vertex within the separation in the infinity norm")
+    {
+        // Face in the plane x + y + z = 0 and a vertex at a Euclidean
+        // distance √3 d but an infinity-norm distance d of the plane
+        const double d = 0.1, min_distance = 1.5 * d;
+        const Eigen::Vector3d v0(d, d, d);
+        const Eigen::Vector3d f0(-1, -1, 2), f1(2, -1, -1), f2(-1, 2, -1);
+        if (is_minimum_separation_method(method)) {
+            const bool hit = vertexFaceMSCCD(
+                v0, f0, f1, f2, v0, f0, f1, f2, min_distance, method);
+            setZeroMotionFastPath(false);
+            const bool expected = vertexFaceMSCCD(
+                v0, f0, f1, f2, v0, f0, f1, f2, min_distance, method);
+            setZeroMotionFastPath(true);
+            CHECK(hit == expected);
+            if (method == CCDMethod::TIGHT_INCLUSION) {
+                CHECK(hit);
+            }
+        }
+    }
+
+    SECTION("Resting vertex within the default minimum separation")
+    {
+        // MSRF looks for collisions within DEFAULT_MIN_DISTANCE.
+        const Eigen::Vector3d v0(0, 5e-9, 0);
+        const bool hit = vertexFaceCCD(v0, v1, v2, v3, v0, v1, v2, v3, method);
+        if (method == CCDMethod::MIN_SEPARATION_ROOT_FINDER) {
+            CHECK(hit);
+            CHECK(zeroMotionStats().num_answered == 0);
+        } else {
+            CHECK(!hit);
+        }
+    }
+
+    SECTION("Resting vertex on the face")
+    {
+        const Eigen::Vector3d v0(0, 0, 0);
+        CHECK(vertexFaceCCD(v0, v1, v2, v3, v0, v1, v2, v3, method));
+        CHECK(zeroMotionStats().num_static == 1);
+        CHECK(zeroMotionStats().num_answered == 0);
+    }
+
+    SECTION("Edges translated together")
+    {
+        const Eigen::Vector3d d(0.5, 0.25, -2);
+        const Eigen::Vector3d a0(-1, 0, 0), a1(1, 0, 0);
+        const Eigen::Vector3d b0(0, -1, 0.5), b1(0, 1, 0.25);
+        CHECK(!edgeEdgeCCD(
+            a0, a1, b0, b1, a0 + d, a1 + d, b0 + d, b1 + d, method));
+        CHECK(zeroMotionStats().num_translating == 1);
+        CHECK(zeroMotionStats().num_answered == 1);
+    }
+
+    SECTION("Disabled")
+    {
+        setZeroMotionFastPath(false);
+        const Eigen::Vector3d v0(0, 0.5, 0);
+        CHECK(
+            (!vertexFaceCCD(v0, v1, v2, v3, v0, v1, v2, v3, method)
+             || is_conservative_method(method)));
+        CHECK(zeroMotionStats().num_queries == 0);
+        setZeroMotionFastPath(true);
+    }
+}
+
+TEST_CASE("Zero-motion fast path is conservative", "[ccd][filter]")
+{
+    std::mt19937 gen(2);
+    std::uniform_real_distribution<double> position(-1, 1);
+    std::uniform_real_distribution<double> distance(0, 0.5);
+
+    const int n = 40;
+    int num_rejected = 0;
+    for (int q = 0; q < 2000; q++) {
+        const int num_first_points = 1 + q % 2;
+        Eigen::Vector3d p[4];
+        for (Eigen::Vector3d& pi : p) {
+            pi = Eigen::Vector3d(position(gen), position(gen), position(gen));
+        }
+
+        const bool touching = q % 4 < 2;
+        double min_distance = distance(gen);
+        if (touching) {
+            // Move the first primitive onto the second one, up to rounding.
+            const Eigen::Vector3d first = num_first_points == 1
+                ? p[0]
+                : Eigen::Vector3d((p[0] + p[1]) / 2);
+            const Eigen::Vector3d second = num_first_points == 1
+                ? Eigen::Vector3d((p[1] + p[2] + p[3]) / 3)
+                : Eigen::Vector3d((p[2] + p[3]) / 2);
+            for (int i = 0; i < num_first_points; i++) {
+                p[i] += second - first;
+            }
+            min_distance = 1e-12;
+        }
+
+        // Upper bound of the distance between the primitives by sampling
+        double sampled = std::numeric_limits<double>::infinity();
+        for (int i = 0; i <= n; i++) {
+            const int j_max = num_first_points == 1 ? n - i : n;
+            for (int j = 0; j <= j_max; j++) {
+                const double s = double(i) / n, t = double(j) / n;
+                Eigen::Vector3d a, b;
+                if (num_first_points == 1) {
+                    a = p[0];
+                    b = (1 - s - t) * p[1] + s * p[2] + t * p[3];
+                } else {
+                    a = (1 - s) * p[0] + s * p[1];
+                    b = (1 - t) * p[2] + t * p[3];
+                }
+                // The infinity norm is at most the Euclidean distance.
+                sampled = std::min(
+                    sampled, (a - b).lpNorm<Eigen::Infinity>());
+            }
+        }
+
+        const bool rejected = kernels::are_static_primitives_apart(
+            num_first_points, { &p[0], &p[1], &p[2], &p[3] }, min_distance);
+        num_rejected += rejected;
+        CAPTURE(q, sampled, min_distance);
+        CHECK(!(rejected && (touching || sampled <= min_distance)));
+    }
+    CHECK(num_rejected > 0);
+}
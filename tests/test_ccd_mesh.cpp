@@ -0,0 +1,325 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ccd.hpp>
+#include <ccd_mesh.hpp>
+
+namespace {
+
+// A static triangle, a vertex falling through it, a vertex missing it, and a
+// moving edge crossing two of the triangle's edges.
+void mesh(
+    Eigen::MatrixXd& V0,
+    Eigen::MatrixXd& V1,
+    Eigen::MatrixXi& E,
+    Eigen::MatrixXi& F)
+{
+    V0.resize(7, 3);
+    V0 << -1, 0, 1,   //
+        1, 0, 1,      //
+        0, 0, -1,     //
+        0, 1, 0,      //
+        5, 1, 0,      //
+        0.25, -1, -1, //
+        0.25, -1, 1.5;
+    V1 = V0;
+    V1.row(3) << 0, -1, 0;
+    V1.row(4) << 5, -1, 0;
+    V1.row(5) << 0.25, 1, -1;
+    V1.row(6) << 0.25, 1, 1.5;
+
+    E.resize(4, 2);
+    E << 0, 1, //
+        1, 2,  //
+        2, 0,  //
+        5, 6;
+
+    F.resize(1, 3);
+    F << 0, 1, 2;
+}
+
+Eigen::Vector3d row(const Eigen::MatrixXd& V, long i) { return V.row(i); }
+
+} // namespace
+
+TEST_CASE("Mesh CCD matches scalar CCD", "[ccd][mesh]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    mesh(V0, V1, E, F);
+
+    SECTION("Vertex-face")
+    {
+        const std::vector<VertexFaceCandidate> candidates = { { 3, 0 },
+                                                              { 4, 0 } };
+        std::unique_ptr<bool[]> hits(new bool[candidates.size()]);
+        std::vector<CCDResult> results(candidates.size());
+        meshVertexFaceCCD(V0, V1, F, candidates, method, hits.get());
+        meshVertexFaceCCD(V0, V1, F, candidates, method, results.data());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            CAPTURE(i);
+            const long v = candidates[i].vertex_id, f = candidates[i].face_id;
+            CCDResult expected;
+            vertexFaceCCD(
+                row(V0, v), row(V0, F(f, 0)), row(V0, F(f, 1)),
+                row(V0, F(f, 2)), row(V1, v), row(V1, F(f, 0)),
+                row(V1, F(f, 1)), row(V1, F(f, 2)), method, expected);
+            CHECK(hits[i] == expected.hit);
+            CHECK(results[i].hit == expected.hit);
+            CHECK(results[i].toi == expected.toi);
+        }
+        CHECK(hits[0]);
+    }
+
+    SECTION("Edge-edge")
+    {
+        const std::vector<EdgeEdgeCandidate> candidates = { { 0, 3 },
+                                                            { 1, 3 },
+                                                            { 2, 3 } };
+        std::unique_ptr<bool[]> hits(new bool[candidates.size()]);
+        std::vector<CCDResult> results(candidates.size());
+        meshEdgeEdgeCCD(V0, V1, E, candidates, method, hits.get());
+        meshEdgeEdgeCCD(V0, V1, E, candidates, method, results.data());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            CAPTURE(i);
+            const long e0 = candidates[i].edge0_id;
+            const long e1 = candidates[i].edge1_id;
+            CCDResult expected;
+            edgeEdgeCCD(
+                row(V0, E(e0, 0)), row(V0, E(e0, 1)), row(V0, E(e1, 0)),
+                row(V0, E(e1, 1)), row(V1, E(e0, 0)), row(V1, E(e0, 1)),
+                row(V1, E(e1, 0)), row(V1, E(e1, 1)), method, expected);
+            CHECK(hits[i] == expected.hit);
+            CHECK(results[i].hit == expected.hit);
+            CHECK(results[i].toi == expected.toi);
+        }
+    }
+}
+
+TEST_CASE("Mesh MSCCD matches scalar MSCCD", "[ccd][mesh][msccd]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method) || !is_minimum_separation_method(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    const double min_distance = GENERATE(0.0, 1e-3, 0.1);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    mesh(V0, V1, E, F);
+
+    SECTION("Vertex-face")
+    {
+        const std::vector<VertexFaceCandidate> candidates = { { 3, 0 },
+                                                              { 4, 0 } };
+        std::unique_ptr<bool[]> hits(new bool[candidates.size()]);
+        meshVertexFaceMSCCD(
+            V0, V1, F, candidates, min_distance, method, hits.get());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            CAPTURE(i);
+            const long v = candidates[i].vertex_id, f = candidates[i].face_id;
+            CHECK(
+                hits[i]
+                == vertexFaceMSCCD(
+                    row(V0, v), row(V0, F(f, 0)), row(V0, F(f, 1)),
+                    row(V0, F(f, 2)), row(V1, v), row(V1, F(f, 0)),
+                    row(V1, F(f, 1)), row(V1, F(f, 2)), min_distance,
+                    method));
+        }
+    }
+
+    SECTION("Edge-edge")
+    {
+        const std::vector<EdgeEdgeCandidate> candidates = { { 0, 3 },
+                                                            { 1, 3 },
+                                                            { 2, 3 } };
+        std::unique_ptr<bool[]> hits(new bool[candidates.size()]);
+        meshEdgeEdgeMSCCD(
+            V0, V1, E, candidates, min_distance, method, hits.get());
+        for (size_t i = 0; i < candidates.size(); i++) {
+            CAPTURE(i);
+            const long e0 = candidates[i].edge0_id;
+            const long e1 = candidates[i].edge1_id;
+            CHECK(
+                hits[i]
+                == edgeEdgeMSCCD(
+                    row(V0, E(e0, 0)), row(V0, E(e0, 1)), row(V0, E(e1, 0)),
+                    row(V0, E(e1, 1)), row(V1, E(e0, 0)), row(V1, E(e0, 1)),
+                    row(V1, E(e1, 0)), row(V1, E(e1, 1)), min_distance,
+                    method));
+        }
+    }
+}
+
+TEST_CASE("Earliest time of impact of a mesh", "[ccd][mesh][toi]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    mesh(V0, V1, E, F);
+
+    const std::vector<VertexFaceCandidate> vf_candidates = { { 4, 0 },
+                                                             { 3, 0 } };
+    const std::vector<EdgeEdgeCandidate> ee_candidates = { { 0, 3 },
+                                                           { 1, 3 },
+                                                           { 2, 3 } };
+
+    std::vector<CCDResult> vf_results(vf_candidates.size());
+    std::vector<CCDResult> ee_results(ee_candidates.size());
+    meshVertexFaceCCD(V0, V1, F, vf_candidates, method, vf_results.data());
+    meshEdgeEdgeCCD(V0, V1, E, ee_candidates, method, ee_results.data());
+    double expected = std::numeric_limits<double>::infinity();
+    for (const CCDResult& result : vf_results) {
+        expected = std::min(expected, result.toi);
+    }
+    for (const CCDResult& result : ee_results) {
+        expected = std::min(expected, result.toi);
+    }
+
+    const double toi =
+        meshEarliestTOI(V0, V1, E, F, vf_candidates, ee_candidates, method);
+    CHECK(toi == Approx(expected).margin(1e-3));
+    CHECK(toi >= 0);
+    CHECK(toi <= 1);
+
+    CHECK(
+        meshEarliestTOI(V0, V1, E, F, {}, {}, method)
+        == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Geometric refinement policy", "[ccd][mesh][toi]")
+{
+    ccd::GeometricRefinementPolicy policy;
+    CHECK(policy.num_levels(1e-6) == 3);
+    CHECK(policy.level_tolerance(0, 1e-6) == 1e-2);
+    CHECK(policy.level_tolerance(1, 1e-6) == Approx(1e-4));
+    CHECK(policy.level_max_iter(0, 1000) == 1000);
+    // The tolerance of the query is already coarse.
+    CHECK(policy.num_levels(0.1) == 1);
+
+    policy.coarse_tolerance = 1e-3;
+    policy.factor = 0.1;
+    CHECK(policy.num_levels(1e-6) == 4);
+}
+
+TEST_CASE("Adaptive earliest time of impact of a mesh", "[ccd][mesh][toi]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    mesh(V0, V1, E, F);
+
+    const std::vector<VertexFaceCandidate> vf_candidates = { { 4, 0 },
+                                                             { 3, 0 } };
+    const std::vector<EdgeEdgeCandidate> ee_candidates = { { 0, 3 },
+                                                           { 1, 3 },
+                                                           { 2, 3 } };
+    const GeometricRefinementPolicy policy;
+
+    const double expected =
+        meshEarliestTOI(V0, V1, E, F, vf_candidates, ee_candidates, method);
+    const double toi = meshEarliestTOI(
+        V0, V1, E, F, vf_candidates, ee_candidates, method, policy);
+    CHECK(toi == Approx(expected).margin(1e-3));
+    CHECK(toi >= 0);
+    CHECK(toi <= 1);
+
+    CHECK(
+        meshEarliestTOI(V0, V1, E, F, {}, {}, method, policy)
+        == std::numeric_limits<double>::infinity());
+    CHECK(
+        meshEarliestTOI(V0, V1, E, F, { { 4, 0 } }, {}, method, policy)
+        == std::numeric_limits<double>::infinity());
+
+    if (is_minimum_separation_method(method)) {
+        const double ms_expected = meshEarliestMSTOI(
+            V0, V1, E, F, vf_candidates, ee_candidates, 1e-3, method);
+        CHECK(
+            meshEarliestMSTOI(
+                V0, V1, E, F, vf_candidates, ee_candidates, 1e-3, method,
+                policy)
+            == Approx(ms_expected).margin(1e-3));
+    }
+}
+
+TEST_CASE("Any hit of a mesh", "[ccd][mesh][any_hit]")
+{
+    using namespace ccd;
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    AnyHitOrder order = GENERATE(
+        AnyHitOrder::INPUT, AnyHitOrder::SWEPT_BOX_OVERLAP);
+
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method], int(order));
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    mesh(V0, V1, E, F);
+    Executor executor(4);
+
+    // Many copies of the candidates, whose results are the same
+    std::vector<VertexFaceCandidate> vf_candidates(1000, { 4, 0 });
+    std::vector<EdgeEdgeCandidate> ee_candidates(1000, { 0, 3 });
+    std::unique_ptr<bool[]> hits(new bool[1]);
+    meshVertexFaceCCD(V0, V1, F, { { 4, 0 } }, method, hits.get());
+    const bool vf_hit = hits[0];
+    meshEdgeEdgeCCD(V0, V1, E, { { 0, 3 } }, method, hits.get());
+    const bool ee_hit = hits[0];
+
+    CHECK(
+        meshAnyHit(V0, V1, E, F, vf_candidates, ee_candidates, method, order)
+        == (vf_hit || ee_hit));
+    CHECK(
+        meshAnyHit(
+            executor, V0, V1, E, F, vf_candidates, ee_candidates, method,
+            order)
+        == (vf_hit || ee_hit));
+
+    // A single colliding candidate at the end
+    vf_candidates.back() = { 3, 0 };
+    CHECK(meshAnyHit(V0, V1, E, F, vf_candidates, {}, method, order));
+    CHECK(
+        meshAnyHit(executor, V0, V1, E, F, vf_candidates, {}, method, order));
+
+    CHECK(!meshAnyHit(V0, V1, E, F, {}, {}, method, order));
+    CHECK(!meshAnyHit(executor, V0, V1, E, F, {}, {}, method, order));
+
+    if (is_minimum_separation_method(method)) {
+        CHECK(meshAnyMSHit(
+            V0, V1, E, F, vf_candidates, {}, 1e-3, method, order));
+        CHECK(meshAnyMSHit(
+            executor, V0, V1, E, F, vf_candidates, {}, 1e-3, method, order));
+    }
+}
@@ -0,0 +1,124 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+
+#include <ccd.hpp>
+#include <ccd_normalization.hpp>
+
+using namespace ccd;
+
+TEST_CASE("Normalize query", "[ccd][normalization]")
+{
+    SECTION("Far from the origin")
+    {
+        std::mt19937 gen(0);
+        std::uniform_real_distribution<double> position(-1, 1);
+
+        for (int q = 0; q < 1000; q++) {
+            Eigen::Vector3d x[8], shifted[8];
+            for (int i = 0; i < 8; i++) {
+                x[i] = Eigen::Vector3d(1e3, -1e4, 1e5)
+                    + Eigen::Vector3d(
+                           position(gen), position(gen), position(gen));
+                shifted[i] = x[i];
+            }
+            REQUIRE(kernels::normalize_query(shifted));
+            CHECK(shifted[0] == Eigen::Vector3d::Zero());
+            for (int i = 0; i < 8; i++) {
+                // The translation is exact.
+                CHECK(shifted[i] + x[0] == x[i]);
+                CHECK(shifted[i].cwiseAbs().maxCoeff() < 4);
+            }
+        }
+    }
+
+    SECTION("Around the origin")
+    {
+        Eigen::Vector3d x[8];
+        for (int i = 0; i < 8; i++) {
+            x[i] = Eigen::Vector3d(i % 2 ? 1e-20 : 1, 0, 1 + i);
+        }
+        const Eigen::Vector3d x4 = x[4];
+        CHECK(kernels::normalize_query(x));
+        // Only the last axis is shifted.
+        CHECK(x[4].x() == x4.x());
+        CHECK(x[4].y() == x4.y());
+        CHECK(x[4].z() == 4);
+
+        for (int i = 0; i < 8; i++) {
+            x[i] = Eigen::Vector3d(i % 2 ? 1e-20 : 1, 0, i % 2 ? -1e-20 : 1);
+        }
+        CHECK(!kernels::normalize_query(x));
+    }
+}
+
+TEST_CASE("Normalized queries in the methods", "[ccd][normalization]")
+{
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    CHECK(!isQueryNormalizationEnabled());
+    setQueryNormalization(true);
+    resetQueryNormalizationStats();
+
+    // A vertex crossing a moving face far from the origin
+    const Eigen::Vector3d offset(1e4, 1e4, 1e4);
+    const Eigen::Vector3d v0 = Eigen::Vector3d(0, 1, 0) + offset;
+    const Eigen::Vector3d v1 = Eigen::Vector3d(-1, 0, 1) + offset;
+    const Eigen::Vector3d v2 = Eigen::Vector3d(1, 0, 1) + offset;
+    const Eigen::Vector3d v3 = Eigen::Vector3d(0, 0, -1) + offset;
+    const Eigen::Vector3d v0_end = Eigen::Vector3d(0, -1, 0) + offset;
+    const Eigen::Vector3d v3_end = Eigen::Vector3d(0, 0, -1.5) + offset;
+
+    CCDResult result;
+    CHECK(vertexFaceCCD(
+        v0, v1, v2, v3, v0_end, v1, v2, v3_end, method, result));
+    if (is_time_of_impact_computed(method)) {
+        CHECK(result.toi <= 0.5);
+    }
+
+    // The same vertex missing the face
+    const Eigen::Vector3d v0_miss = Eigen::Vector3d(3, 1, 0) + offset;
+    const Eigen::Vector3d v0_miss_end = Eigen::Vector3d(3, -1, 0) + offset;
+    CCDResult miss;
+    vertexFaceCCD(
+        v0_miss, v1, v2, v3, v0_miss_end, v1, v2, v3_end, method, miss);
+    CHECK((!miss.hit || is_conservative_method(method)));
+
+    const NormalizationStats stats = queryNormalizationStats();
+    CHECK(stats.num_queries <= 2);
+    CHECK(stats.num_shifted == stats.num_queries);
+
+    setQueryNormalization(false);
+}
+
+TEST_CASE("Normalization keeps exact answers", "[ccd][normalization]")
+{
+    if (!is_method_enabled(CCDMethod::RATIONAL_ROOT_PARITY)) {
+        return;
+    }
+    const CCDMethod method = CCDMethod::RATIONAL_ROOT_PARITY;
+
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(99, 101);
+
+    for (int q = 0; q < 100; q++) {
+        Eigen::Vector3d x[8];
+        for (Eigen::Vector3d& xi : x) {
+            xi = Eigen::Vector3d(position(gen), position(gen), position(gen));
+        }
+        setQueryNormalization(false);
+        const bool hit = edgeEdgeCCD(
+            x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7], method);
+        setQueryNormalization(true);
+        CAPTURE(q);
+        CHECK(
+            hit
+            == edgeEdgeCCD(
+                x[0], x[1], x[2], x[3], x[4], x[5], x[6], x[7], method));
+    }
+    setQueryNormalization(false);
+}
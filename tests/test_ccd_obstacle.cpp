@@ -0,0 +1,220 @@
+#include <catch2/catch.hpp>
+
+#include <random>
+
+#include <ccd.hpp>
+#include <ccd_obstacle.hpp>
+
+using namespace ccd;
+using kernels::ObstacleAnswer;
+
+namespace {
+
+ObstacleAnswer static_face_answer(
+    const Eigen::Vector3d& p0,
+    const Eigen::Vector3d& p1,
+    const Eigen::Vector3d& a,
+    const Eigen::Vector3d& b,
+    const Eigen::Vector3d& c)
+{
+    return kernels::static_obstacle_query(
+        /*num_first_points=*/1, { &p0, &a, &b, &c, &p1, &a, &b, &c },
+        /*count=*/false);
+}
+
+} // namespace
+
+TEST_CASE("Static face kernel", "[ccd][obstacle]")
+{
+    const Eigen::Vector3d a(-1, 0, 1), b(1, 0, 1), c(0, 0, -1);
+
+    SECTION("Vertex crossing the face")
+    {
+        const ObstacleAnswer answer = static_face_answer(
+            Eigen::Vector3d(0, 1, 0), Eigen::Vector3d(0, -3, 0), a, b, c);
+        CHECK(answer.kind == ObstacleAnswer::HIT);
+        CHECK(answer.toi_lower <= 0.25);
+        CHECK(answer.toi_upper >= 0.25);
+        CHECK(answer.toi_upper - answer.toi_lower < 1e-12);
+    }
+
+    SECTION("Vertex crossing the plane outside the face")
+    {
+        const ObstacleAnswer answer = static_face_answer(
+            Eigen::Vector3d(3, 1, 0), Eigen::Vector3d(3, -1, 0), a, b, c);
+        CHECK(answer.kind == ObstacleAnswer::NO_HIT);
+    }
+
+    SECTION("Vertex not reaching the plane")
+    {
+        const ObstacleAnswer answer = static_face_answer(
+            Eigen::Vector3d(0, 2, 0), Eigen::Vector3d(0, 1e-300, 0), a, b, c);
+        CHECK(answer.kind == ObstacleAnswer::NO_HIT);
+    }
+
+    SECTION("Vertex crossing an edge of the face")
+    {
+        const ObstacleAnswer answer = static_face_answer(
+            Eigen::Vector3d(0, 1, 1), Eigen::Vector3d(0, -1, 1), a, b, c);
+        CHECK(answer.kind == ObstacleAnswer::UNDECIDED);
+    }
+
+    SECTION("Vertex moving in the plane of the face")
+    {
+        const ObstacleAnswer answer = static_face_answer(
+            Eigen::Vector3d(-3, 0, 0), Eigen::Vector3d(3, 0, 0), a, b, c);
+        CHECK(answer.kind == ObstacleAnswer::UNDECIDED);
+
+        double toi;
+        CHECK(vertexStaticFaceCCD(
+            Eigen::Vector3d(-3, 0, 0), Eigen::Vector3d(-2, 0, 0), a, b, c,
+            toi));
+        CHECK(toi == 0);
+    }
+}
+
+TEST_CASE("Static face kernel is exact", "[ccd][obstacle]")
+{
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> position(-1, 1);
+
+    int num_decided = 0;
+    for (int q = 0; q < 10'000; q++) {
+        Eigen::Vector3d x[5];
+        for (Eigen::Vector3d& xi : x) {
+            xi = Eigen::Vector3d(position(gen), position(gen), position(gen));
+        }
+        const ObstacleAnswer answer =
+            static_face_answer(x[0], x[1], x[2], x[3], x[4]);
+        REQUIRE(answer.kind != ObstacleAnswer::NONE);
+        if (answer.kind == ObstacleAnswer::UNDECIDED) {
+            continue;
+        }
+        num_decided++;
+
+        // Reference answer in extended precision
+        using Vector3l = Eigen::Matrix<long double, 3, 1>;
+        const Vector3l p0 = x[0].cast<long double>();
+        const Vector3l p1 = x[1].cast<long double>();
+        const Vector3l a = x[2].cast<long double>();
+        const Vector3l b = x[3].cast<long double>();
+        const Vector3l c = x[4].cast<long double>();
+        const Vector3l n = (b - a).cross(c - a);
+        const long double f0 = n.dot(p0 - a), f1 = n.dot(p1 - a);
+        bool hit = false;
+        long double t = -1;
+        if ((f0 > 0) != (f1 > 0)) {
+            t = f0 / (f0 - f1);
+            const Vector3l p = p0 + t * (p1 - p0);
+            hit = n.dot((b - a).cross(p - a)) >= 0
+                && n.dot((c - b).cross(p - b)) >= 0
+                && n.dot((a - c).cross(p - c)) >= 0;
+        }
+        CAPTURE(q);
+        CHECK(hit == (answer.kind == ObstacleAnswer::HIT));
+        if (hit) {
+            CHECK(answer.toi_lower <= t);
+            CHECK(answer.toi_upper >= t);
+        }
+    }
+    CHECK(num_decided > 9'000);
+}
+
+TEST_CASE("Static edge kernel", "[ccd][obstacle]")
+{
+    const Eigen::Vector3d a0(-1, 0, 0), a1(1, 0, 0);
+    const Eigen::Vector3d b0(0, -1, 1), b1(0, 1, 1);
+
+    // The first edge moves below the second one.
+    const Eigen::Vector3d b0_below(0, -1, 0.5), b1_below(0, 1, 0.25);
+    CHECK(
+        kernels::static_obstacle_query(
+            2, { &b0, &b1, &a0, &a1, &b0_below, &b1_below, &a0, &a1 }, false)
+            .kind
+        == ObstacleAnswer::NO_HIT);
+    // Same with the second edge moving
+    CHECK(
+        kernels::static_obstacle_query(
+            2, { &a0, &a1, &b0, &b1, &a0, &a1, &b0_below, &b1_below }, false)
+            .kind
+        == ObstacleAnswer::NO_HIT);
+
+    // The first edge moves through the second one.
+    const Eigen::Vector3d b0_end(0, -1, -1), b1_end(0, 1, -1);
+    CHECK(
+        kernels::static_obstacle_query(
+            2, { &b0, &b1, &a0, &a1, &b0_end, &b1_end, &a0, &a1 }, false)
+            .kind
+        == ObstacleAnswer::UNDECIDED);
+
+    double toi;
+    CHECK(edgeStaticEdgeCCD(b0, b1, b0_end, b1_end, a0, a1, toi));
+    CHECK(toi == 0);
+    CHECK(!edgeStaticEdgeCCD(b0, b1, b0_below, b1_below, a0, a1, toi));
+    CHECK(toi == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Static obstacle kernels in the methods", "[ccd][obstacle]")
+{
+    CCDMethod method = CCDMethod(GENERATE(range(0, int(NUM_CCD_METHODS))));
+    if (!is_method_enabled(method)) {
+        return;
+    }
+    CAPTURE(method_names[method]);
+
+    CHECK(areStaticObstacleKernelsEnabled());
+    resetStaticObstacleStats();
+
+    const Eigen::Vector3d a(-1, 0, 1), b(1, 0, 1), c(0, 0, -1);
+
+    // The plain functions of MIN_SEPARATION_ROOT_FINDER keep a default minimum
+    // separation, so they always run the method.
+    const int specialised =
+        method == CCDMethod::MIN_SEPARATION_ROOT_FINDER ? 0 : 1;
+
+    SECTION("Decided")
+    {
+        const Eigen::Vector3d v0(0, 1, 0), v0_end(0, -1, 0);
+        CCDResult result;
+        CHECK(vertexFaceCCD(v0, a, b, c, v0_end, a, b, c, method, result));
+        if (is_time_of_impact_computed(method)) {
+            CHECK(result.toi == Approx(0.5));
+        }
+
+        const Eigen::Vector3d v1(3, 1, 0), v1_end(3, -1, 0);
+        CHECK(!vertexFaceCCD(v1, a, b, c, v1_end, a, b, c, method));
+
+        const StaticObstacleStats stats = staticObstacleStats();
+        CHECK(stats.num_queries == 2 * specialised);
+        CHECK(stats.num_positives == specialised);
+        CHECK(stats.num_negatives == specialised);
+        if (specialised) {
+            CHECK(stats.decided_rate() == 1);
+        }
+    }
+
+    SECTION("Undecided queries run the method")
+    {
+        const Eigen::Vector3d v0(0, 1, 1), v0_end(0, -1, 1);
+        CHECK(vertexFaceCCD(v0, a, b, c, v0_end, a, b, c, method));
+        CHECK(staticObstacleStats().num_queries == specialised);
+        CHECK(staticObstacleStats().decided_rate() == 0);
+    }
+
+    SECTION("Vertex within the default minimum separation")
+    {
+        const Eigen::Vector3d v0(0, 5e-9, -3), v0_end(0, 5e-9, 3);
+        CHECK(
+            vertexFaceCCD(v0, a, b, c, v0_end, a, b, c, method)
+            == (method == CCDMethod::MIN_SEPARATION_ROOT_FINDER));
+    }
+
+    SECTION("Disabled")
+    {
+        setStaticObstacleKernels(false);
+        const Eigen::Vector3d v0(0, 1, 0), v0_end(0, -1, 0);
+        CHECK(vertexFaceCCD(v0, a, b, c, v0_end, a, b, c, method));
+        CHECK(staticObstacleStats().num_queries == 0);
+        setStaticObstacleKernels(true);
+    }
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+
+#include <algorithm>
+#include <vector>
+
+#include <ccd_representative_triangles.hpp>
+
+#include "broad_phase_meshes.hpp"
+
+using namespace ccd;
+
+TEST_CASE("Face-face pairs match brute force", "[ccd][broad_phase][rt]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    std::vector<SweptBox> vertex_boxes, edge_boxes, face_boxes;
+    sweptBoxes(V0, V1, E, F, 0, vertex_boxes, edge_boxes, face_boxes);
+    std::vector<FaceFaceCandidate> expected;
+    for (long f0 = 0; f0 < F.rows(); f0++) {
+        for (long f1 = f0 + 1; f1 < F.rows(); f1++) {
+            if (face_boxes[f0].intersects(face_boxes[f1])) {
+                expected.push_back({ f0, f1 });
+            }
+        }
+    }
+
+    std::vector<FaceFaceCandidate> ff_candidates;
+    faceFaceCandidates(V0, V1, F, ff_candidates);
+    REQUIRE(ff_candidates.size() == expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        CHECK(ff_candidates[i].face0_id == expected[i].face0_id);
+        CHECK(ff_candidates[i].face1_id == expected[i].face1_id);
+    }
+
+    Executor executor(4);
+    std::vector<FaceFaceCandidate> parallel_candidates;
+    faceFaceCandidates(executor, V0, V1, F, parallel_candidates);
+    CHECK(parallel_candidates.size() == expected.size());
+}
+
+TEST_CASE(
+    "Representative triangles own each feature", "[ccd][broad_phase][rt]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(4, 0, V0, V1, E, F);
+    const RepresentativeTriangles triangles(E, F);
+
+    std::vector<int> vertex_counts(V0.rows(), 0);
+    for (long f = 0; f < F.rows(); f++) {
+        for (int i = 0; i < 3; i++) {
+            if (triangles.vertex_owner(F(f, i)) == f) {
+                vertex_counts[F(f, i)]++;
+            }
+        }
+    }
+    for (long e = 0; e < E.rows(); e++) {
+        const long f = triangles.edge_owner(e);
+        REQUIRE(f >= 0);
+        // The owner is incident to the edge.
+        CHECK((F.row(f).array() == E(e, 0)).any());
+        CHECK((F.row(f).array() == E(e, 1)).any());
+    }
+    CHECK(std::all_of(
+        vertex_counts.begin(), vertex_counts.end(),
+        [](const int count) { return count == 1; }));
+    CHECK(triangles.vertex_owner(V0.rows()) == -1);
+}
+
+TEST_CASE(
+    "Representative triangles issue each pair once", "[ccd][broad_phase][rt]")
+{
+    const bool cull = GENERATE(false, true);
+    CAPTURE(cull);
+    setAdjacencyCulling(cull);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+    const RepresentativeTriangles triangles(E, F);
+
+    std::vector<FaceFaceCandidate> ff_candidates;
+    faceFaceCandidates(V0, V1, F, ff_candidates);
+    std::vector<VertexFaceCandidate> vf_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    triangles.candidates(ff_candidates, vf_candidates, ee_candidates);
+
+    // Expanding the pairs of faces one at a time gives no duplicates (without
+    // culling, every call would also expand the faces with themselves).
+    std::vector<VertexFaceCandidate> vf;
+    std::vector<EdgeEdgeCandidate> ee;
+    if (cull) {
+        std::vector<VertexFaceCandidate> all_vf;
+        std::vector<EdgeEdgeCandidate> all_ee;
+        for (const FaceFaceCandidate& pair : ff_candidates) {
+            triangles.candidates({ pair }, vf, ee);
+            all_vf.insert(all_vf.end(), vf.begin(), vf.end());
+            all_ee.insert(all_ee.end(), ee.begin(), ee.end());
+        }
+        const size_t num_vf = all_vf.size(), num_ee = all_ee.size();
+        broad_phase::sort_candidates(all_vf);
+        broad_phase::sort_candidates(all_ee);
+        CHECK(all_vf.size() == num_vf);
+        CHECK(all_ee.size() == num_ee);
+        CHECK(all_vf == vf_candidates);
+        CHECK(all_ee == ee_candidates);
+    }
+
+    // Every pair whose boxes intersect is a candidate.
+    std::vector<VertexFaceCandidate> expected_vf;
+    std::vector<EdgeEdgeCandidate> expected_ee;
+    brute_force_candidates(V0, V1, E, F, 0, expected_vf, expected_ee);
+    REQUIRE(!expected_vf.empty());
+    REQUIRE(!expected_ee.empty());
+    CHECK(std::includes(
+        vf_candidates.begin(), vf_candidates.end(), expected_vf.begin(),
+        expected_vf.end(),
+        [](const VertexFaceCandidate& a, const VertexFaceCandidate& b) {
+            return std::make_pair(a.vertex_id, a.face_id)
+                < std::make_pair(b.vertex_id, b.face_id);
+        }));
+    CHECK(std::includes(
+        ee_candidates.begin(), ee_candidates.end(), expected_ee.begin(),
+        expected_ee.end(),
+        [](const EdgeEdgeCandidate& a, const EdgeEdgeCandidate& b) {
+            return std::make_pair(a.edge0_id, a.edge1_id)
+                < std::make_pair(b.edge0_id, b.edge1_id);
+        }));
+
+    Executor executor(4);
+    triangles.candidates(executor, ff_candidates, vf, ee);
+    CHECK(vf == vf_candidates);
+    CHECK(ee == ee_candidates);
+
+    setAdjacencyCulling(true);
+}
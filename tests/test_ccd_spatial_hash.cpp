@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include <ccd_spatial_hash.hpp>
+
+#include "broad_phase_meshes.hpp"
+
+using namespace ccd;
+
+TEST_CASE("Spatial hash matches brute force", "[ccd][broad_phase][hash]")
+{
+    const double inflation_radius = GENERATE(0.0, 1e-2);
+    // Automatic, smaller, and larger than the primitives
+    const double cell_size = GENERATE(0.0, 1e-3, 0.1, 10.0);
+    CAPTURE(inflation_radius, cell_size);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    std::vector<VertexFaceCandidate> expected_vf;
+    std::vector<EdgeEdgeCandidate> expected_ee;
+    brute_force_candidates(
+        V0, V1, E, F, inflation_radius, expected_vf, expected_ee);
+    REQUIRE(!expected_vf.empty());
+    REQUIRE(!expected_ee.empty());
+
+    std::vector<VertexFaceCandidate> vf_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    spatialHashCandidates(
+        V0, V1, E, F, vf_candidates, ee_candidates, inflation_radius,
+        cell_size);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    Executor executor(4);
+    spatialHashCandidates(
+        executor, V0, V1, E, F, vf_candidates, ee_candidates,
+        inflation_radius, cell_size);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+}
+
+TEST_CASE("Spatial hash of degenerate meshes", "[ccd][broad_phase][hash]")
+{
+    std::vector<VertexFaceCandidate> vf_candidates = { { 0, 0 } };
+    std::vector<EdgeEdgeCandidate> ee_candidates = { { 0, 1 } };
+
+    SECTION("Empty mesh")
+    {
+        spatialHashCandidates(
+            Eigen::MatrixXd(0, 3), Eigen::MatrixXd(0, 3),
+            Eigen::MatrixXi(0, 2), Eigen::MatrixXi(0, 3), vf_candidates,
+            ee_candidates);
+        CHECK(vf_candidates.empty());
+        CHECK(ee_candidates.empty());
+    }
+
+    SECTION("Static points")
+    {
+        Eigen::MatrixXd V(4, 3);
+        V << 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0;
+        Eigen::MatrixXi E(2, 2), F(1, 3);
+        E << 0, 1, 2, 3;
+        F << 1, 2, 3;
+        spatialHashCandidates(V, V, E, F, vf_candidates, ee_candidates);
+        // The vertices of the face are culled as adjacent.
+        CHECK(vf_candidates.size() == 1);
+        CHECK(ee_candidates.size() == 1);
+    }
+}
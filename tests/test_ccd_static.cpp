@@ -0,0 +1,135 @@
+#include <catch2/catch.hpp>
+
+#include <type_traits>
+#include <utility>
+
+#include <ccd.hpp>
+#include <ccd_static.hpp>
+
+namespace {
+
+using namespace ccd;
+
+template <bool value> using Bool = std::integral_constant<bool, value>;
+
+// A vertex falling through a triangle and an edge falling through another
+// edge, both offset horizontally by x so some queries hit and some miss.
+void queries(
+    const double x, Eigen::Vector3d vf[8], Eigen::Vector3d ee[8])
+{
+    vf[0] << x, 1, 0;
+    vf[1] << -1, 0, 1;
+    vf[2] << 1, 0, 1;
+    vf[3] << 0, 0, -1;
+    vf[4] << x, -1, 0;
+    for (int i = 5; i < 8; i++) {
+        vf[i] = vf[i - 4];
+    }
+
+    ee[0] << x - 1, 1, 0;
+    ee[1] << x + 1, 1, 0;
+    ee[2] << 0, 0, -1;
+    ee[3] << 0, 0, 1;
+    ee[4] << x - 1, -1, 0;
+    ee[5] << x + 1, -1, 0;
+    ee[6] = ee[2];
+    ee[7] = ee[3];
+}
+
+// Disabled methods do not compile, so they are skipped by tag dispatch.
+template <CCDMethod method> void check_ccd(std::false_type) { }
+
+template <CCDMethod method> void check_ccd(std::true_type)
+{
+    CAPTURE(method_names[method]);
+    for (const double x : { -2.0, -0.5, 0.0, 0.25, 2.0 }) {
+        CAPTURE(x);
+        Eigen::Vector3d vf[8], ee[8];
+        queries(x, vf, ee);
+
+        CCDResult expected, actual;
+        vertexFaceCCD(
+            vf[0], vf[1], vf[2], vf[3], vf[4], vf[5], vf[6], vf[7], method,
+            expected);
+        CHECK(
+            vertexFaceCCD<method>(
+                vf[0], vf[1], vf[2], vf[3], vf[4], vf[5], vf[6], vf[7], actual)
+            == expected.hit);
+        CHECK(actual.toi == expected.toi);
+        CHECK(
+            VertexFaceCCD<method>()(
+                vf[0], vf[1], vf[2], vf[3], vf[4], vf[5], vf[6], vf[7])
+            == expected.hit);
+
+        edgeEdgeCCD(
+            ee[0], ee[1], ee[2], ee[3], ee[4], ee[5], ee[6], ee[7], method,
+            expected);
+        CHECK(
+            edgeEdgeCCD<method>(
+                ee[0], ee[1], ee[2], ee[3], ee[4], ee[5], ee[6], ee[7], actual)
+            == expected.hit);
+        CHECK(actual.toi == expected.toi);
+        CHECK(
+            EdgeEdgeCCD<method>()(
+                ee[0], ee[1], ee[2], ee[3], ee[4], ee[5], ee[6], ee[7])
+            == expected.hit);
+    }
+}
+
+template <CCDMethod method> void check_msccd(std::false_type) { }
+
+template <CCDMethod method> void check_msccd(std::true_type)
+{
+    CAPTURE(method_names[method]);
+    for (const double x : { -2.0, -0.5, 0.0, 0.25, 2.0 }) {
+        CAPTURE(x);
+        Eigen::Vector3d vf[8], ee[8];
+        queries(x, vf, ee);
+
+        const double d = 1e-3;
+        CCDResult expected, actual;
+        vertexFaceMSCCD(
+            vf[0], vf[1], vf[2], vf[3], vf[4], vf[5], vf[6], vf[7], d, method,
+            expected);
+        CHECK(
+            vertexFaceMSCCD<method>(
+                vf[0], vf[1], vf[2], vf[3], vf[4], vf[5], vf[6], vf[7], d,
+                actual)
+            == expected.hit);
+        CHECK(actual.toi == expected.toi);
+
+        edgeEdgeMSCCD(
+            ee[0], ee[1], ee[2], ee[3], ee[4], ee[5], ee[6], ee[7], d, method,
+            expected);
+        CHECK(
+            edgeEdgeMSCCD<method>(
+                ee[0], ee[1], ee[2], ee[3], ee[4], ee[5], ee[6], ee[7], d,
+                actual)
+            == expected.hit);
+        CHECK(actual.toi == expected.toi);
+    }
+}
+
+template <int... methods>
+void check_all(std::integer_sequence<int, methods...>)
+{
+    using expand = int[];
+    (void)expand { 0,
+                   (check_ccd<CCDMethod(methods)>(
+                        Bool<is_method_enabled(CCDMethod(methods))>()),
+                    0)... };
+    (void)expand { 0,
+                   (check_msccd<CCDMethod(methods)>(
+                        Bool<
+                            is_method_enabled(CCDMethod(methods))
+                            && is_minimum_separation_method(
+                                CCDMethod(methods))>()),
+                    0)... };
+}
+
+} // namespace
+
+TEST_CASE("Compile-time method CCD matches runtime CCD", "[ccd][static]")
+{
+    check_all(std::make_integer_sequence<int, NUM_CCD_METHODS>());
+}
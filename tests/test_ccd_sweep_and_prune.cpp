@@ -0,0 +1,119 @@
+#include <catch2/catch.hpp>
+
+#include <vector>
+
+#include <ccd_sweep_and_prune.hpp>
+
+#include "broad_phase_meshes.hpp"
+
+using namespace ccd;
+
+TEST_CASE("Sweep and prune matches brute force", "[ccd][broad_phase][sap]")
+{
+    const double inflation_radius = GENERATE(0.0, 1e-2);
+    CAPTURE(inflation_radius);
+
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    std::vector<VertexFaceCandidate> expected_vf;
+    std::vector<EdgeEdgeCandidate> expected_ee;
+    brute_force_candidates(
+        V0, V1, E, F, inflation_radius, expected_vf, expected_ee);
+    REQUIRE(!expected_vf.empty());
+    REQUIRE(!expected_ee.empty());
+
+    std::vector<VertexFaceCandidate> vf_candidates;
+    std::vector<EdgeEdgeCandidate> ee_candidates;
+    SweepAndPrune sap;
+    sap.build(V0, V1, E, F, inflation_radius);
+    sap.candidates(vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    Executor executor(4);
+    sap.build(executor, V0, V1, E, F, inflation_radius);
+    sap.candidates(executor, vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+
+    SECTION("Sorted incrementally at the next time step")
+    {
+        // Small motion, so that the order barely changes.
+        const Eigen::MatrixXd W0 = V0 + 1e-3 * (V1 - V0);
+        const Eigen::MatrixXd W1 = V1 + 1e-3 * (V1 - V0);
+        brute_force_candidates(
+            W0, W1, E, F, inflation_radius, expected_vf, expected_ee);
+
+        CHECK(!sap.update(executor, W0, W1, inflation_radius));
+        sap.candidates(executor, vf_candidates, ee_candidates);
+        CHECK(vf_candidates == expected_vf);
+        CHECK(ee_candidates == expected_ee);
+
+        // Translation, so that the order does not change.
+        const Eigen::RowVector3d t(0.5, 0.25, 0);
+        CHECK(!sap.update(
+            W0.rowwise() + t, W1.rowwise() + t, inflation_radius));
+        CHECK(sap.num_swaps() == 0);
+        sap.candidates(vf_candidates, ee_candidates);
+        CHECK(vf_candidates.size() == expected_vf.size());
+        CHECK(ee_candidates.size() == expected_ee.size());
+    }
+
+    SECTION("Sorted from scratch when the order is reversed")
+    {
+        const Eigen::MatrixXd W0 = -V0, W1 = -V1;
+        brute_force_candidates(
+            W0, W1, E, F, inflation_radius, expected_vf, expected_ee);
+
+        CHECK(sap.update(W0, W1, inflation_radius));
+        sap.candidates(vf_candidates, ee_candidates);
+        CHECK(vf_candidates == expected_vf);
+        CHECK(ee_candidates == expected_ee);
+    }
+}
+
+TEST_CASE("Sweep and prune axis", "[ccd][broad_phase][sap]")
+{
+    Eigen::MatrixXd V0, V1;
+    Eigen::MatrixXi E, F;
+    random_cloth(10, 0, V0, V1, E, F);
+
+    // The cloth spans x and y, and stretching it along y makes y the axis of
+    // greatest variance.
+    Eigen::MatrixXd W0 = V0, W1 = V1;
+    W0.col(1) *= 2;
+    W1.col(1) *= 2;
+    SweepAndPrune sap;
+    sap.build(W0, W1, E, F);
+    CHECK(sap.axis() == 1);
+
+    // Then rotate it so that it spans z.
+    W0.col(1).swap(W0.col(2));
+    W1.col(1).swap(W1.col(2));
+    CHECK(sap.update(W0, W1));
+    CHECK(sap.axis() == 2);
+
+    std::vector<VertexFaceCandidate> expected_vf, vf_candidates;
+    std::vector<EdgeEdgeCandidate> expected_ee, ee_candidates;
+    brute_force_candidates(W0, W1, E, F, 0, expected_vf, expected_ee);
+    sap.candidates(vf_candidates, ee_candidates);
+    CHECK(vf_candidates == expected_vf);
+    CHECK(ee_candidates == expected_ee);
+}
+
+TEST_CASE("Sweep and prune of an empty mesh", "[ccd][broad_phase][sap]")
+{
+    std::vector<VertexFaceCandidate> vf_candidates = { { 0, 0 } };
+    std::vector<EdgeEdgeCandidate> ee_candidates = { { 0, 1 } };
+
+    SweepAndPrune sap;
+    sap.build(
+        Eigen::MatrixXd(0, 3), Eigen::MatrixXd(0, 3), Eigen::MatrixXi(0, 2),
+        Eigen::MatrixXi(0, 3));
+    CHECK(!sap.update(Eigen::MatrixXd(0, 3), Eigen::MatrixXd(0, 3)));
+    sap.candidates(vf_candidates, ee_candidates);
+    CHECK(vf_candidates.empty());
+    CHECK(ee_candidates.empty());
+}
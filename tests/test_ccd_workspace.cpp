@@ -0,0 +1,199 @@
+#include <catch2/catch.hpp>
+
+#include <cstdlib>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <ccd_workspace.hpp>
+
+#if CCD_WRAPPER_WITH_RRP || CCD_WRAPPER_WITH_RFRP
+#include <gmp.h>
+#endif
+
+using namespace ccd;
+
+TEST_CASE("Workspace reuses freed memory", "[workspace]")
+{
+    Workspace workspace;
+    const size_t size = GENERATE(1, 16, 17, 100, 2048);
+    CAPTURE(size);
+
+    for (int run = 0; run < 3; run++) {
+        std::vector<void*> blocks;
+        for (int i = 0; i < 100; i++) {
+            blocks.push_back(workspace.allocate(size));
+            REQUIRE(blocks.back() != nullptr);
+        }
+        for (void* block : blocks) {
+            workspace.deallocate(block);
+        }
+    }
+    CHECK(workspace.num_heap_allocations() == 0);
+
+    void* block = workspace.allocate(size);
+    workspace.deallocate(block);
+    CHECK(workspace.allocate(size) == block);
+    workspace.deallocate(block);
+}
+
+TEST_CASE("Workspace falls back to the heap", "[workspace]")
+{
+    SECTION("Large allocations")
+    {
+        Workspace workspace;
+        void* block = workspace.allocate(size_t(1) << 16);
+        REQUIRE(block != nullptr);
+        CHECK(workspace.num_heap_allocations() == 1);
+        workspace.deallocate(block);
+    }
+
+    SECTION("Full arena")
+    {
+        Workspace workspace(/*arena_size=*/0);
+        std::vector<void*> blocks;
+        for (int i = 0; i < 1000; i++) {
+            blocks.push_back(workspace.allocate(2048));
+            REQUIRE(blocks.back() != nullptr);
+        }
+        CHECK(workspace.num_heap_allocations() > 0);
+        for (void* block : blocks) {
+            workspace.deallocate(block);
+        }
+    }
+}
+
+TEST_CASE("Workspace memory freed on another thread", "[workspace]")
+{
+    Workspace workspace;
+    void* block = workspace.allocate(64);
+    std::thread([&] {
+        Workspace other;
+        other.deallocate(block);
+    }).join();
+    CHECK(workspace.allocate(64) == block);
+    CHECK(workspace.num_heap_allocations() == 0);
+    workspace.deallocate(block);
+}
+
+TEST_CASE("Workspace memory outlives the workspace", "[workspace]")
+{
+    std::unique_ptr<Workspace> workspace(new Workspace);
+    int* block = static_cast<int*>(workspace->allocate(sizeof(int)));
+    workspace.reset();
+    *block = 42;
+    CHECK(*block == 42);
+    Workspace other;
+    other.deallocate(block);
+}
+
+TEST_CASE("Workspace scopes", "[workspace]")
+{
+    Workspace a, b;
+    CHECK(Workspace::current() == nullptr);
+    {
+        Workspace::Scope scope_a(a);
+        CHECK(Workspace::current() == &a);
+        {
+            Workspace::Scope scope_b(b);
+            CHECK(Workspace::current() == &b);
+        }
+        CHECK(Workspace::current() == &a);
+        std::thread([] { CHECK(Workspace::current() == nullptr); }).join();
+    }
+    CHECK(Workspace::current() == nullptr);
+}
+
+TEST_CASE("GMP allocation is opt-in", "[workspace]")
+{
+    CHECK(!isWorkspaceGMPAllocationEnabled());
+    CHECK(setWorkspaceGMPAllocation(false));
+}
+
+#if CCD_WRAPPER_WITH_RRP || CCD_WRAPPER_WITH_RFRP
+namespace {
+
+// Memory functions of the application, counting the allocations and the
+// blocks in use
+size_t num_application_allocations = 0;
+size_t num_application_blocks = 0;
+
+void* application_allocate(size_t size)
+{
+    num_application_allocations++;
+    num_application_blocks++;
+    return std::malloc(size);
+}
+
+void* application_reallocate(void* ptr, size_t, size_t new_size)
+{
+    return std::realloc(ptr, new_size);
+}
+
+void application_free(void* ptr, size_t)
+{
+    num_application_blocks--;
+    std::free(ptr);
+}
+
+} // namespace
+
+TEST_CASE("GMP allocates from the workspace", "[workspace]")
+{
+    mp_set_memory_functions(
+        &application_allocate, &application_reallocate, &application_free);
+    mpz_t before;
+    mpz_init_set_ui(before, 1);
+    mpz_mul_2exp(before, before, 1000);
+    REQUIRE(num_application_blocks == 1);
+
+    REQUIRE(setWorkspaceGMPAllocation(true));
+    CHECK(isWorkspaceGMPAllocationEnabled());
+
+    const auto compute = [] {
+        mpq_t x, y;
+        mpq_init(x);
+        mpq_init(y);
+        mpq_set_d(x, 0.1);
+        for (int i = 0; i < 100; i++) {
+            mpq_set_d(y, 1e-3 * i);
+            mpq_mul(y, y, x);
+            mpq_add(x, x, y);
+        }
+        mpq_clear(x);
+        mpq_clear(y);
+    };
+
+    {
+        Workspace workspace;
+        Workspace::Scope scope(workspace);
+        compute(); // Warm up the free lists
+        const size_t num_heap_allocations = workspace.num_heap_allocations();
+        compute();
+        CHECK(workspace.num_heap_allocations() == num_heap_allocations);
+        CHECK(num_application_blocks == 1);
+
+        // Memory of the application is freed by the application.
+        mpz_clear(before);
+        CHECK(num_application_blocks == 0);
+    }
+
+    // Without a workspace, GMP allocates with the application's functions.
+    mpz_t after;
+    mpz_init_set_ui(after, 1);
+    mpz_mul_2exp(after, after, 1000);
+    CHECK(num_application_blocks == 1);
+    mpz_clear(after);
+
+    setWorkspaceGMPAllocation(false);
+    CHECK(!isWorkspaceGMPAllocationEnabled());
+    {
+        Workspace workspace;
+        Workspace::Scope scope(workspace);
+        const size_t num_allocations = num_application_allocations;
+        compute();
+        CHECK(num_application_allocations > num_allocations);
+        CHECK(num_application_blocks == 0);
+    }
+}
+#endif